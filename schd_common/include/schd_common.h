@@ -12,6 +12,8 @@
 #include "schd_pref.h"
 #include "schd_core.h"
 #include "schd_planner.h"
+#include "schd_native.h"
+#include "schd_msg.h"
 
 // Simulation infrastructure
 #include "schd_assert.h"
@@ -24,6 +24,11 @@ std::string& pt2str(
       const boost_pt::ptree& pt_,
       std::string&           str_ );
 
+// Same conversion without the report. Returns error message, empty if OK. Used outside the simulation thread
+std::string pt2str_err(
+      const boost_pt::ptree& pt_,
+      std::string&           str_ );
+
 } // namespace schd
 
 #endif /* SCHD_COMMON_INCLUDE_SCHD_CONV_PTREE_H_ */
@@ -21,7 +21,7 @@ namespace boost {
       size_t operator()(boost::property_tree::basic_ptree<Key, Data, KeyCompare> const& pt) const {
          std::size_t seed = 0;
 
-         boost::hash_combine(seed, pt.template get_value<std::string>());
+         boost::hash_combine(seed, pt.data()); // Hash the stored value. No conversion through the translator
          boost::hash_range(seed, pt.begin(), pt.end());
          return seed;
       }
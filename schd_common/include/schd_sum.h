@@ -0,0 +1,75 @@
+/*
+ * schd_sum.h
+ *
+ *  Description:
+ *    Running sum in the signed 128-bit integer fixed point: 63 integer and 64 fractional bits.
+ *    Each value is rounded once to the resolution of 2^-64, then the additions are exact.
+ *    Values are below 2^54, which leaves the headroom for the sum of 512 maximal values.
+ *    The running sum is range checked before each operation, so it never overflows.
+ *    The result does not depend on the order of the operations, so the running total which
+ *    is updated incrementally is bit-identical to the total which is summed from scratch
+ */
+
+#ifndef SCHD_COMMON_INCLUDE_SCHD_SUM_H_
+#define SCHD_COMMON_INCLUDE_SCHD_SUM_H_
+
+#include <cmath>
+#include "schd_report.h"
+
+namespace schd {
+
+   class schd_sum_c {
+   public:
+      void add(
+            double val ) {
+         acc( to_fix( val ));
+      }
+
+      void sub(
+            double val ) {
+         acc( -to_fix( val ));
+      }
+
+      double value(
+            void ) const {
+         return std::ldexp( static_cast<double>( sum ), -FRAC_BITS );
+      }
+
+      void clear(
+            void ) {
+         sum = 0;
+      }
+
+   private:
+      __extension__ typedef          __int128 fix_t;
+      __extension__ typedef unsigned __int128 ufix_t;
+
+      static const int FRAC_BITS = 64;
+      static const int INT_BITS  = 54;    // Headroom for the sum of 2^9 maximal values
+
+      fix_t sum = 0;
+
+      static fix_t to_fix(
+            double val ) {
+         if( !( std::fabs( val ) < std::ldexp( 1.0, INT_BITS ))) {
+            SCHD_REPORT_ERROR( "schd::sum" ) << " Value is out of range: " << val;
+         }
+
+         return static_cast<fix_t>( std::nearbyint( std::ldexp( val, FRAC_BITS )));
+      }
+
+      void acc(
+            fix_t fix ) {
+         const fix_t fix_max = static_cast<fix_t>( ~static_cast<ufix_t>( 0 ) >> 1 );
+
+         if( fix > 0 ? sum > fix_max - fix : sum < -fix_max - fix ) {
+            SCHD_REPORT_ERROR( "schd::sum" ) << " Sum is out of range";
+         }
+         else {
+            sum += fix;
+         }
+      }
+   }; // class schd_sum_c
+} // namespace schd
+
+#endif /* SCHD_COMMON_INCLUDE_SCHD_SUM_H_ */
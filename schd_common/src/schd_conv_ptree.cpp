@@ -39,21 +39,35 @@ std::string& pt2str(
       const boost_pt::ptree& pt_,
       std::string&           str_ ) {
 
+   std::string err = pt2str_err( pt_, str_ );
+
+   if( !err.empty()) {
+      SCHD_REPORT_ERROR( "simd::dump" ) << err;
+   }
+
+   return str_;
+} // std::string& pt2str(
+
+std::string pt2str_err(
+      const boost_pt::ptree& pt_,
+      std::string&           str_ ) {
+
    std::stringstream os;
+   std::string       err;
 
    try {
       boost_pt::write_json( os, pt_ );
    }
-   catch( const boost_jp::json_parser_error& err ) {
-      SCHD_REPORT_ERROR( "simd::dump" ) << err.what();
+   catch( const boost_jp::json_parser_error& err_jp ) {
+      err = err_jp.what();
    }
    catch( ... ) {
-      SCHD_REPORT_ERROR( "simd::dump" ) << "Unexpected";
+      err = "Unexpected";
    }
 
    str_ = os.str();
 
-   return str_;
-} // std::string& pt2str(
+   return err;
+} // std::string pt2str_err(
 
 } // namespace simd
@@ -33,29 +33,77 @@ int sc_main(
    schd::schd_trace.save_map(
          schd::schd_pref.thrd_p );
 
-   // Top-level connections
-   schd::schd_core_c    core_i0(
-         "core" );
-   core_i0.init(
+   // IDs of the names in the messages
+   schd::schd_msg_ids.init(
          schd::schd_pref.exec_p,
-         schd::schd_pref.cres_p );
+         schd::schd_pref.cres_p,
+         schd::schd_pref.thrd_p,
+         schd::schd_pref.task_p );
+
+   // Simulation engine
+   bool engine_native = false;
+
+   if( schd::schd_pref.core_p.is_initialized()) {
+      boost::optional<std::string> engine_p =
+            schd::schd_pref.core_p.get().get_optional<std::string>("engine");
+
+      if( !engine_p.is_initialized() || engine_p.get() == "systemc" ) {
+         engine_native = false;
+      }
+      else if( engine_p.get() == "native" ) {
+         engine_native = true;
+      }
+      else {
+         SCHD_REPORT_ERROR( "schd::main" ) << "Unsupported simulation engine: " << engine_p.get();
+      }
+   }
+
+   // Top-level connections
+   schd::schd_core_c   *core_i0   = NULL;
+   schd::schd_native_c *native_i0 = NULL;
+
+   if( engine_native ) {
+      SCHD_REPORT_INFO( "schd::main" ) << "Native simulation engine";
+
+      native_i0 = new schd::schd_native_c(
+            "core" );
+   }
+   else {
+      core_i0 = new schd::schd_core_c(
+            "core" );
+      core_i0->init(
+            schd::schd_pref.exec_p,
+            schd::schd_pref.cres_p,
+            schd::schd_pref.core_p );
+   }
 
    schd::schd_planner_c plan_i0(
          "planner" );
    plan_i0.init(
          schd::schd_pref.thrd_p,
          schd::schd_pref.task_p,
-         schd::schd_pref.exec_p );
-
-   plan_i0.core_i.bind(
-         core_i0.plan_ei );
+         schd::schd_pref.exec_p,
+         schd::schd_pref.core_p );
+
+   if( engine_native ) {
+      native_i0->init(
+            schd::schd_pref.exec_p,
+            schd::schd_pref.cres_p,
+            schd::schd_pref.core_p,
+            plan_i0 );
+   }
+   else {
+      plan_i0.core_i.bind(
+            core_i0->plan_ei );
 
-   plan_i0.core_o.bind(
-         core_i0.plan_eo );
+      plan_i0.core_o.bind(
+            core_i0->plan_eo );
+   }
 
    // Init data dump class
    schd::schd_dump.init(
-         schd::schd_pref.dump_p );
+         schd::schd_pref.dump_p,
+         schd::schd_pref.core_p );
 
    // Invoke the simulation
    if( schd::schd_time.end_sec != 0.0 ) {
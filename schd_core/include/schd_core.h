@@ -9,12 +9,15 @@
 #define SCHD_CORE_INCLUDE_SCHD_CORE_H_
 
 #include <map>
+#include <memory>
 #include <string>
 #include <boost/property_tree/ptree.hpp>
 #include <boost/optional.hpp>
 #include <systemc>
 #include "schd_sig_ptree.h"
+#include "schd_fifo.h"
 #include "schd_ptree_xbar.h"
+#include "schd_ptree_disp.h"
 #include "schd_exec.h"
 #include "schd_cres.h"
 
@@ -27,7 +30,7 @@ namespace schd {
 
    public:
       // Module I/O Ports
-      sc_core::sc_export<sc_core::sc_fifo_in_if <schd_sig_ptree_c>> plan_ei;
+      sc_core::sc_export<schd_fifo_in_if<schd_sig_ptree_c>> plan_ei;
       sc_core::sc_export<sc_core::sc_fifo_out_if<schd_sig_ptree_c>> plan_eo;
 
       // Constructor declaration
@@ -36,21 +39,27 @@ namespace schd {
       // Init declaration (to be used after the instantiation and before the port binding)
       void init(
             boost::optional<const boost_pt::ptree&> _exec_p,      // exec section of the preferences
-            boost::optional<const boost_pt::ptree&> _cres_p );    // cres section of the preferences
+            boost::optional<const boost_pt::ptree&> _cres_p,      // cres section of the preferences
+            boost::optional<const boost_pt::ptree&> _core_p );    // core options
 
    private:
+      void init_xbar(                                         // planner, exec and cres are connected with the xbars
+            const boost_pt::ptree& plan_list_pt,
+            const boost_pt::ptree& exec_list_pt,
+            const boost_pt::ptree& cres_list_pt );
+
+      void init_direct(                                       // ... with the dispatch tables
+            void );
+
       typedef struct {
          std::size_t                             idx;    // Block index
          boost::optional<schd_exec_c&>           mod_p;  // Pointer to module
          boost::optional<const boost_pt::ptree&> pref_p; // Pointer to preferences
-         boost::optional<sc_core::sc_fifo<schd_sig_ptree_c>&> chn_plan_exec_p;
-         boost::optional<sc_core::sc_fifo<schd_sig_ptree_c>&> chn_exec_plan_p;
-         boost::optional<sc_core::sc_fifo<schd_sig_ptree_c>&> chn_cres_exec_p;
-         boost::optional<sc_core::sc_fifo<schd_sig_ptree_c>&> chn_exec_cres_p;
-         static const int chn_plan_exec_size = 64;
-         static const int chn_exec_plan_size = 64;
-         static const int chn_cres_exec_size = 64;
-         static const int chn_exec_cres_size = 64;
+         boost::optional<schd_fifo_c<schd_sig_ptree_c>&> chn_plan_exec_p;
+         boost::optional<schd_fifo_c<schd_sig_ptree_c>&> chn_exec_plan_p;
+         boost::optional<schd_fifo_c<schd_sig_ptree_c>&> chn_cres_exec_p;
+         boost::optional<schd_fifo_c<schd_sig_ptree_c>&> chn_exec_cres_p;
+         std::size_t                             chn_size; // Initial size of the channels
       } schd_exec_info_t;
 
       typedef std::map<std::string, schd_exec_info_t> exec_list_t;
@@ -60,20 +69,30 @@ namespace schd {
          std::size_t                             idx;    // Block index
          boost::optional<schd_cres_c&>           mod_p;  // Pointer to module
          boost::optional<const boost_pt::ptree&> pref_p; // Pointer to preferences
-         boost::optional<sc_core::sc_fifo<schd_sig_ptree_c>&> chn_cres_exec_p;
-         boost::optional<sc_core::sc_fifo<schd_sig_ptree_c>&> chn_exec_cres_p;
-         static const int chn_cres_exec_size = 64;
-         static const int chn_exec_cres_size = 64;
+         boost::optional<schd_fifo_c<schd_sig_ptree_c>&> chn_cres_exec_p;
+         boost::optional<schd_fifo_c<schd_sig_ptree_c>&> chn_exec_cres_p;
+         std::size_t                             chn_size; // Initial size of the channels
       } schd_cres_info_t;
 
       typedef std::map<std::string, schd_cres_info_t> cres_list_t;
       cres_list_t cres_list;
 
-      sc_core::sc_fifo<schd_sig_ptree_c> chn_core_plan;
-      sc_core::sc_fifo<schd_sig_ptree_c> chn_plan_core;
+      schd_fifo_c<schd_sig_ptree_c> chn_core_plan;
+      schd_fifo_c<schd_sig_ptree_c> chn_plan_core;
+
+      // Initial size of the channels. Channels grow when they are full
+      std::size_t chn_size = 64;
+
+      std::size_t chn_size_get(
+            const boost_pt::ptree& pref );
 
-      static const int chn_core_plan_size = 64;
-      static const int chn_plan_core_size = 64;
+      // Capacities of the common resources indexed by the ID. Shared by all exec blocks
+      std::shared_ptr<const schd_exec_c::cres_cap_list_t> cres_cap_get(
+            const boost_pt::ptree& cres_pt );
+
+      // Rank of the common resources in the order of the names, indexed by the ID. Shared by all exec blocks
+      std::shared_ptr<const schd_exec_c::cres_rank_list_t> cres_rank_get(
+            const boost_pt::ptree& cres_pt );
 
       schd_ptree_xbar_c mux_plan_exec;
       schd_ptree_xbar_c mux_exec_plan;
@@ -81,6 +100,15 @@ namespace schd {
       schd_ptree_xbar_c mux_cres_exec;
       schd_ptree_xbar_c mux_exec_cres;
 
+      // Direct interconnect: producers write straight into the FIFOs of the destinations
+      bool direct_en = false;
+
+      schd_ptree_disp_c disp_plan_exec;
+      schd_ptree_disp_c disp_exec_plan;
+
+      schd_ptree_disp_c disp_cres_exec;
+      schd_ptree_disp_c disp_exec_cres;
+
    }; // SC_MODULE( schd_core_c )
 } // namespace schd
 
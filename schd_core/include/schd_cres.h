@@ -10,11 +10,15 @@
 
 #include <list>
 #include <string>
+#include <vector>
 #include <map>
 #include <boost/property_tree/ptree.hpp>
 #include <boost/optional.hpp>
 #include <systemc>
 #include "schd_sig_ptree.h"
+#include "schd_fifo.h"
+#include "schd_msg.h"
+#include "schd_sum.h"
 
 // Short alias for the namespace
 namespace boost_pt = boost::property_tree;
@@ -25,7 +29,7 @@ namespace schd {
 
    public:
       // Module I/O Ports
-      sc_core::sc_port<sc_core::sc_fifo_in_if <schd_sig_ptree_c>> exec_i;  // Resource request from exec
+      schd_fifo_in<schd_sig_ptree_c>                              exec_i;  // Resource request from exec
       sc_core::sc_port<sc_core::sc_fifo_out_if<schd_sig_ptree_c>> exec_o;  // Demand   update to exec
 
       // Constructor declaration
@@ -34,7 +38,8 @@ namespace schd {
       // Init declaration (to be used after the instantiation and before the port binding)
       void init(
             boost::optional<const boost_pt::ptree&> _pref_p,
-            boost::optional<const boost_pt::ptree&> _exec_p );
+            boost::optional<const boost_pt::ptree&> _exec_p,
+            boost::optional<const boost_pt::ptree&> _core_p );    // core options
 
       void add_trace(
             sc_core::sc_trace_file* tf,
@@ -42,11 +47,18 @@ namespace schd {
 
    private:
       // Process declarations
-      void exec_thrd(
+      void exec_meth(                                       // Statically sensitive to the input
             void );
 
+      schd_dump_buf_c<boost_pt::ptree> dump_buf_exec_i;
+      schd_dump_buf_c<boost_pt::ptree> dump_buf_exec_o;
+
+      std::vector<schd_sig_ptree_c> sig_inp_list;           // Batch of the input signals
+
       // List of the execution blocks demanding from the current common resource
       typedef struct {
+         std::size_t id   = 0;         // exec ID in the messages
+         std::size_t rank = 0;         // Position in the order of the names
          bool   connected = false;     // Common resource is connected with the exec
                                        // during the execution of the current task
          double demand    = 0;         // Demand which is requested by the exec from the planner
@@ -54,6 +66,20 @@ namespace schd {
 
       typedef std::map<std::string, exec_data_t> exec_list_t;
       exec_list_t exec_list;
+      std::vector<exec_list_t::iterator> exec_id_list;   // Execution blocks indexed by the ID
+      std::vector<exec_list_t::iterator> exec_conn_list; // Connected execution blocks in the order of the names
+      schd_sum_c                         demand_sum;     // Total demand of the connected execution blocks
+
+      std::size_t cres_id = 0;                           // ID of this resource in the messages
+
+      // Updates from the execs are coalesced: total demand is broadcast once per delta
+      bool coalesce_en = false;
+
+      std::vector<exec_list_t::iterator> exec_con_list;  // Execs which have connected    since the last broadcast
+      std::vector<exec_list_t::iterator> exec_dcn_list;  // Execs which have disconnected since the last broadcast
+
+      void demand_send(                                  // Broadcast total demand, acknowledge connections
+            void );
 
       // Common resource capacity
       double capacity = 0;
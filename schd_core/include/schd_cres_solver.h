@@ -0,0 +1,88 @@
+/*
+ * schd_cres_solver.h
+ *
+ *  Description:
+ *    Declaration of the centralized solver for the common resource contention.
+ *    Finds the same steady state as the demand handshake between the exec and cres
+ *    modules, without the exchange of the messages.
+ */
+
+#ifndef SCHD_CORE_INCLUDE_SCHD_CRES_SOLVER_H_
+#define SCHD_CORE_INCLUDE_SCHD_CRES_SOLVER_H_
+
+#include <vector>
+#include <utility>
+#include <boost/dynamic_bitset.hpp>
+
+namespace schd {
+
+   class schd_cres_solver_c {
+   public:
+      // Link between the exec and the common resource (element of the sparse exec x cres matrix)
+      class link_t {
+      public:
+         std::size_t cres_idx    = 0;
+         double      plan_demand = 0.0;    // Demand which is requested for the exec from the planner
+         double      exec_demand = 0.0;    // Demand which is reduced when the exec is stalled
+         double      cres_load   = 0.0;    // Total load of the resource = cres demand / capacity
+      };
+
+      typedef std::vector<link_t> row_t;
+
+      void init(
+            const std::vector<double>&      _cres_cap,    // capacity of each cres
+            const std::vector<std::size_t>& _exec_rank,   // rank of each exec in the order of the names
+            const std::vector<std::size_t>& _cres_rank ); // rank of each cres in the order of the names
+
+      // Task starts on the exec: (cres index, demand) list
+      void connect(
+            std::size_t exec_idx,
+            const std::vector<std::pair<std::size_t, double>>& plan_demand );
+
+      // Task ends on the exec
+      void disconnect(
+            std::size_t exec_idx );
+
+      // Update the demands and the time extension coefficients which are affected
+      // by the changes since the last call. Returns true if there was anything to update
+      bool solve(
+            std::vector<std::size_t>& exec_upd );     // execs which were re-evaluated
+
+      double time_ext_coe(
+            std::size_t exec_idx ) const;
+
+      const row_t& row(
+            std::size_t exec_idx ) const;
+
+      double demand(
+            std::size_t cres_idx ) const;
+
+   private:
+      class exec_data_t {
+      public:
+         row_t  row;                          // Connected resources in the order of the names
+         double time_ext_coe = 1.0;           // Time extension coefficient
+      };
+
+      class cres_data_t {
+      public:
+         double                   capacity = 0.0;
+         double                   demand   = 0.0;
+         std::vector<std::size_t> exec_list;  // Connected execs in the order of the names
+      };
+
+      std::vector<exec_data_t> exec_list;
+      std::vector<cres_data_t> cres_list;
+      std::vector<std::size_t> exec_rank;
+      std::vector<std::size_t> cres_rank;
+
+      boost::dynamic_bitset<> exec_dirty;    // execs to re-evaluate the load
+      boost::dynamic_bitset<> cres_dirty;    // cres  to re-evaluate the demand
+
+      link_t& link(
+            std::size_t exec_idx,
+            std::size_t cres_idx );
+   }; // class schd_cres_solver_c
+} // namespace schd
+
+#endif /* SCHD_CORE_INCLUDE_SCHD_CRES_SOLVER_H_ */
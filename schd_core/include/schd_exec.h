@@ -9,11 +9,15 @@
 #define SCHD_CORE_INCLUDE_SCHD_EXEC_H_
 
 #include <string>
-#include <map>
+#include <vector>
+#include <memory>
 #include <boost/property_tree/ptree.hpp>
 #include <boost/optional.hpp>
 #include <systemc>
 #include "schd_sig_ptree.h"
+#include "schd_fifo.h"
+#include "schd_msg.h"
+#include "schd_work.h"
 
 // Short alias for the namespace
 namespace boost_pt = boost::property_tree;
@@ -24,18 +28,26 @@ namespace schd {
 
    public:
       // Module I/O Ports
-      sc_core::sc_port<sc_core::sc_fifo_in_if <schd_sig_ptree_c>> plan_i;
+      schd_fifo_in<schd_sig_ptree_c>                              plan_i;
       sc_core::sc_port<sc_core::sc_fifo_out_if<schd_sig_ptree_c>> plan_o;
-      sc_core::sc_port<sc_core::sc_fifo_in_if <schd_sig_ptree_c>> cres_i;
+      schd_fifo_in<schd_sig_ptree_c>                              cres_i;
       sc_core::sc_port<sc_core::sc_fifo_out_if<schd_sig_ptree_c>> cres_o;
 
+      // Capacities of the common resources indexed by the ID. Shared by all exec blocks
+      typedef std::vector<double> cres_cap_list_t;
+
+      // Rank of the common resources in the order of the names, indexed by the ID. Shared by all exec blocks
+      typedef std::vector<std::size_t> cres_rank_list_t;
+
       // Constructor declaration
       SC_CTOR( schd_exec_c );
 
       // Init declaration (to be used after the instantiation and before the port binding)
       void init(
             boost::optional<const boost_pt::ptree&> _exec_p,      // parameters for the exec module
-            boost::optional<const boost_pt::ptree&> _cres_p );    // parameters for all cres blocks
+            std::shared_ptr<const cres_cap_list_t>  _cres_cap_p,  // capacities of all cres blocks
+            std::shared_ptr<const cres_rank_list_t> _cres_rank_p, // order of the names of all cres blocks
+            boost::optional<const boost_pt::ptree&> _core_p );    // core options
 
       void add_trace(
             sc_core::sc_trace_file* tf,
@@ -43,15 +55,26 @@ namespace schd {
 
    private:
       // Process declarations
-      void exec_thrd(
+      void exec_meth(                                       // Statically sensitive to the inputs and exec_complete
             void );
 
+      schd_dump_buf_c<boost_pt::ptree> dump_buf_plan_i;
+      schd_dump_buf_c<boost_pt::ptree> dump_buf_plan_o;
+      schd_dump_buf_c<boost_pt::ptree> dump_buf_cres_i;
+      schd_dump_buf_c<boost_pt::ptree> dump_buf_cres_o;
+
+      std::vector<schd_sig_ptree_c> sig_inp_list;           // Batch of the input signals
+
       sc_core::sc_time time_upd   = sc_core::SC_ZERO_TIME;  // Time of the most recent update
       sc_core::sc_time time_to_go = sc_core::SC_ZERO_TIME;  // Time to go after the last update
       double           time_ext_coe = 1.0;                  // Time extension coefficient
 
-      std::string      thrd_name;
-      std::string      task_name;
+      // Remaining work is accounted in the integer units instead of scaling time_to_go
+      bool             time_exact_en = false;
+      schd_work_c      work;
+
+      std::size_t      thrd_id = 0;
+      std::size_t      task_id = 0;
       std::string      param_id;
 
       typedef enum : unsigned char {
@@ -63,6 +86,7 @@ namespace schd {
 
       // List of the common resources used in the execution of the current task
       typedef struct {
+         std::size_t  id          = 0;                // Common resource ID in the messages
          double       capacity    = 0.0;              // Common resource Capacity
          bool         connected   = false;
          cres_state_t state       = CRES_STATE_IDLE;  // Common resource is connected with the exec
@@ -74,10 +98,39 @@ namespace schd {
                                                       // involved in the task execution.
       } cres_data_t;
 
-      typedef std::map<std::string, cres_data_t> cres_list_t;
+      // Only the resources of the current task, in the order of the names. Entries are removed when idle
+      typedef std::vector<cres_data_t> cres_list_t;
       cres_list_t cres_list;
 
+      std::shared_ptr<const cres_cap_list_t>  cres_cap_p;
+      std::shared_ptr<const cres_rank_list_t> cres_rank_p;
+
+      cres_list_t::iterator cres_find(                   // Resource of the current task by the ID
+            std::size_t id );
+
+      // Max of cres_load over the current task. Resources which are not connected have zero load
+      double cres_load_max = 0.0;
+
+      void cres_load_set(
+            cres_data_t& cres_data,
+            double       cres_load );
+
+      // Trace copy of the resources indexed by the ID. Allocated only if the trace is enabled
+      std::vector<cres_data_t> cres_trace_list;
+
+      void trace_update(
+            const cres_data_t& cres_data );
+
+      std::size_t exec_id = 0;                           // ID of this exec in the messages
+
+      // Updates from the common resources are coalesced: demands are recalculated once per delta
+      bool coalesce_en = false;
+
+      void demand_update(
+            void );
+
       sc_core::sc_event exec_complete; // Complete execution
+      bool              complete_en = false;   // exec_complete is expected
 
       std::size_t job_hash = 0;
 
@@ -0,0 +1,245 @@
+/*
+ * schd_fifo.h
+ *
+ *  Description:
+ *    Declaration of the primitive FIFO channel which is used between the blocks
+ *    instead of sc_fifo<>. Same delta semantics as sc_fifo<>: data which are written
+ *    become available in the next delta cycle.
+ *    The storage is a ring buffer with the power of two size. The buffer grows when
+ *    it is full, so the writer never blocks. Elements are moved in and out of the buffer
+ */
+
+#ifndef SCHD_CORE_INCLUDE_SCHD_FIFO_H_
+#define SCHD_CORE_INCLUDE_SCHD_FIFO_H_
+
+#include <vector>
+#include <utility>
+#include <systemc>
+
+namespace schd {
+
+   // Input interface with the batch read
+   template <class T>
+   class schd_fifo_in_if : public sc_core::sc_fifo_in_if<T> {
+   public:
+      // Move all the available elements to the end of the list. Returns number of the elements
+      virtual std::size_t read_all(
+            std::vector<T>& list ) = 0;
+   }; // class schd_fifo_in_if
+
+   // Input port. Provides the event finder for the static sensitivity of the methods
+   template <class T>
+   class schd_fifo_in : public sc_core::sc_port<schd_fifo_in_if<T>> {
+   public:
+      typedef schd_fifo_in_if<T> if_type;
+
+      schd_fifo_in(
+            void )
+         : sc_core::sc_port<if_type>() {}
+
+      explicit schd_fifo_in(
+            const char* nm )
+         : sc_core::sc_port<if_type>( nm ) {}
+
+      ~schd_fifo_in(
+            void ) {
+         delete written_finder_p;
+      }
+
+      sc_core::sc_event_finder& data_written(
+            void ) const {
+         if( written_finder_p == NULL ) {
+            written_finder_p = new sc_core::sc_event_finder_t<if_type>(
+                  *this,
+                  &if_type::data_written_event );
+         }
+
+         return *written_finder_p;
+      }
+
+   private:
+      mutable sc_core::sc_event_finder* written_finder_p = NULL;
+   }; // class schd_fifo_in
+
+   template <class T>
+   class schd_fifo_c
+      : public schd_fifo_in_if<T>
+      , public sc_core::sc_fifo_out_if<T>
+      , public sc_core::sc_prim_channel {
+
+   public:
+      explicit schd_fifo_c(
+            const char* nm,
+            std::size_t size = 64 )
+         : sc_core::sc_prim_channel( nm ) {
+         reserve( size );
+      }
+
+      // Initial size of the buffer. Rounded up to the power of two
+      void reserve(
+            std::size_t size ) {
+         std::size_t buf_size = 1;
+
+         while( buf_size < size ) {
+            buf_size <<= 1;
+         }
+
+         if( buf_size > buf.size()) {
+            buf_resize( buf_size );
+         }
+      }
+
+      // Input interface
+      T read(
+            void ) {
+         while( num_readable == 0 ) {
+            sc_core::wait( data_written_ev );
+         }
+
+         T val = std::move( buf[ri] );
+
+         buf[ri] = T();
+         ri      = ( ri + 1 ) & ( buf.size() - 1 );
+
+         num_readable --;
+         num_total    --;
+         num_read     ++;
+         request_update();
+
+         return val;
+      }
+
+      void read(
+            T& val ) {
+         val = read();
+      }
+
+      bool nb_read(
+            T& val ) {
+         if( num_readable == 0 ) {
+            return false;
+         }
+
+         val = read();
+
+         return true;
+      }
+
+      std::size_t read_all(
+            std::vector<T>& list ) {
+         std::size_t num_list = num_readable;
+
+         list.reserve( list.size() + num_list );
+
+         for( std::size_t n = 0; n < num_list; n ++ ) {
+            list.push_back( std::move( buf[ri] ));
+
+            buf[ri] = T();
+            ri      = ( ri + 1 ) & ( buf.size() - 1 );
+         }
+
+         if( num_list != 0 ) {
+            num_readable = 0;
+            num_total   -= num_list;
+            num_read    += num_list;
+            request_update();
+         }
+
+         return num_list;
+      }
+
+      int num_available(
+            void ) const {
+         return static_cast<int>( num_readable );
+      }
+
+      const sc_core::sc_event& data_written_event(
+            void ) const {
+         return data_written_ev;
+      }
+
+      // Output interface
+      void write(
+            const T& val ) {
+         write( T( val ));
+      }
+
+      void write(
+            T&& val ) {
+         if( num_total == buf.size()) {
+            buf_resize( buf.size() << 1 );
+         }
+
+         buf[( ri + num_total ) & ( buf.size() - 1 )] = std::move( val );
+
+         num_total   ++;
+         num_written ++;
+         request_update();
+      }
+
+      bool nb_write(
+            const T& val ) {
+         write( val );
+
+         return true;
+      }
+
+      // Free space before the buffer grows
+      int num_free(
+            void ) const {
+         return static_cast<int>( buf.size() - num_total );
+      }
+
+      const sc_core::sc_event& data_read_event(
+            void ) const {
+         return data_read_ev;
+      }
+
+      const char* kind(
+            void ) const {
+         return "schd_fifo";
+      }
+
+   protected:
+      // Data which are written in the current delta become available in the next one
+      void update(
+            void ) {
+         if( num_read != 0 ) {
+            data_read_ev.notify( sc_core::SC_ZERO_TIME );
+         }
+
+         if( num_written != 0 ) {
+            data_written_ev.notify( sc_core::SC_ZERO_TIME );
+         }
+
+         num_readable = num_total;
+         num_read     = 0;
+         num_written  = 0;
+      }
+
+   private:
+      std::vector<T> buf;               // Ring buffer. Size is the power of two
+      std::size_t    ri           = 0;  // Read index
+      std::size_t    num_total    = 0;  // Elements in the buffer
+      std::size_t    num_readable = 0;  // Elements available to the reader
+      std::size_t    num_read     = 0;  // Elements read    in the current delta
+      std::size_t    num_written  = 0;  // Elements written in the current delta
+
+      sc_core::sc_event data_read_ev;
+      sc_core::sc_event data_written_ev;
+
+      void buf_resize(
+            std::size_t buf_size ) {
+         std::vector<T> buf_new( buf_size );
+
+         for( std::size_t n = 0; n < num_total; n ++ ) {
+            buf_new[n] = std::move( buf[( ri + n ) & ( buf.size() - 1 )] );
+         }
+
+         buf.swap( buf_new );
+         ri = 0;
+      }
+   }; // class schd_fifo_c
+} // namespace schd
+
+#endif /* SCHD_CORE_INCLUDE_SCHD_FIFO_H_ */
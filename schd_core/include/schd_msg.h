@@ -0,0 +1,184 @@
+/*
+ * schd_msg.h
+ *
+ *  Description:
+ *    Declaration of the typed messages which are exchanged between the planner,
+ *    exec and cres blocks. The property tree image of a message is created only
+ *    when it is recorded by a dump buffer
+ */
+
+#ifndef SCHD_CORE_INCLUDE_SCHD_MSG_H_
+#define SCHD_CORE_INCLUDE_SCHD_MSG_H_
+
+#include <vector>
+#include <string>
+#include <unordered_map>
+#include <memory>
+#include <boost/property_tree/ptree.hpp>
+#include <boost/optional.hpp>
+#include <systemc>
+#include "schd_dump.h"
+
+// Short alias for the namespace
+namespace boost_pt = boost::property_tree;
+
+namespace schd {
+
+   // Symbol table of the names which are used in the messages. Names of the exec blocks,
+   // common resources, threads and tasks are mapped to the dense IDs. ID is the index in the
+   // corresponding section of the preferences. For exec and cres it is also the index of the
+   // block port in the xbars. Names are used only for the dumps, traces and reports
+   class schd_msg_ids_c {
+   public:
+      void init(
+            boost::optional<const boost_pt::ptree&> _exec_p,
+            boost::optional<const boost_pt::ptree&> _cres_p,
+            boost::optional<const boost_pt::ptree&> _thrd_p,
+            boost::optional<const boost_pt::ptree&> _task_p );
+
+      std::size_t exec_id(
+            const std::string& name ) const;
+
+      std::size_t cres_id(
+            const std::string& name ) const;
+
+      std::size_t thrd_id(
+            const std::string& name ) const;
+
+      std::size_t task_id(
+            const std::string& name ) const;
+
+      const std::string& exec_name(
+            std::size_t id ) const;
+
+      const std::string& cres_name(
+            std::size_t id ) const;
+
+      const std::string& thrd_name(
+            std::size_t id ) const;
+
+      const std::string& task_name(
+            std::size_t id ) const;
+
+      std::size_t exec_size(
+            void ) const;
+
+      std::size_t cres_size(
+            void ) const;
+
+   private:
+      class sym_table_t {
+      public:
+         std::vector<std::string>                     name_list;
+         std::unordered_map<std::string, std::size_t> id_map;
+      };
+
+      sym_table_t exec_sym;
+      sym_table_t cres_sym;
+      sym_table_t thrd_sym;
+      sym_table_t task_sym;
+
+      void sym_add(                                 // Add names from the section of the preferences
+            boost::optional<const boost_pt::ptree&> _list_p,
+            sym_table_t&                            sym,
+            const std::string&                      sym_type );
+
+      std::size_t sym_id(
+            const sym_table_t& sym,
+            const std::string& sym_type,
+            const std::string& name ) const;
+   }; // class schd_msg_ids_c
+
+   extern schd_msg_ids_c schd_msg_ids;
+
+   // Base class of the messages
+   class schd_msg_c {
+   public:
+      std::vector<std::size_t> dst;   // Destination IDs. Empty if the channel has a single destination
+
+      virtual ~schd_msg_c( void ) {}
+
+      // Property tree image of the message. Same format as used by the blocks before the typed messages
+      virtual void to_ptree(
+            boost_pt::ptree& pt ) const = 0;
+
+      virtual std::size_t hash(
+            void ) const = 0;
+   }; // class schd_msg_c
+
+   // planner -> exec: task to run
+   class schd_msg_plan_exec_t : public schd_msg_c {
+   public:
+      class cres_t {
+      public:
+         std::size_t id     = 0;     // cres ID
+         double      demand = 0.0;   // Demand of the task
+      };
+
+      std::size_t                             thrd_id = 0; // Thread ID
+      std::size_t                             task_id = 0; // Task   ID
+      boost::optional<const boost_pt::ptree&> param;     // Parameters of the task call
+      boost::optional<const boost_pt::ptree&> options;   // exec options
+      sc_core::sc_time                        runtime = sc_core::SC_ZERO_TIME;
+      std::vector<cres_t>                     cres_list; // Common resources
+
+      void to_ptree(
+            boost_pt::ptree& pt ) const;
+
+      std::size_t hash(
+            void ) const;
+   }; // class schd_msg_plan_exec_t
+
+   // exec -> planner: execution is complete
+   class schd_msg_exec_plan_t : public schd_msg_c {
+   public:
+      std::size_t src = 0;   // exec ID
+
+      void to_ptree(
+            boost_pt::ptree& pt ) const;
+
+      std::size_t hash(
+            void ) const;
+   }; // class schd_msg_exec_plan_t
+
+   // exec -> cres: demand of the exec
+   class schd_msg_exec_cres_t : public schd_msg_c {
+   public:
+      std::size_t src       = 0;       // exec ID
+      bool        connected = false;   // Connection state
+      double      demand    = 0.0;     // Resource demand from the exec
+
+      void to_ptree(
+            boost_pt::ptree& pt ) const;
+
+      std::size_t hash(
+            void ) const;
+   }; // class schd_msg_exec_cres_t
+
+   // cres -> exec: total demand of the resource
+   class schd_msg_cres_exec_t : public schd_msg_c {
+   public:
+      std::size_t src       = 0;       // cres ID
+      double      demand    = 0.0;     // Total demand of the resource
+      bool        connected = false;   // Connection state
+
+      void to_ptree(
+            boost_pt::ptree& pt ) const;
+
+      std::size_t hash(
+            void ) const;
+   }; // class schd_msg_cres_exec_t
+
+   typedef std::shared_ptr<const schd_msg_c>           schd_msg_ptr;
+   typedef std::shared_ptr<const schd_msg_plan_exec_t> schd_msg_plan_exec_ptr;
+   typedef std::shared_ptr<const schd_msg_exec_plan_t> schd_msg_exec_plan_ptr;
+   typedef std::shared_ptr<const schd_msg_exec_cres_t> schd_msg_exec_cres_ptr;
+   typedef std::shared_ptr<const schd_msg_cres_exec_t> schd_msg_cres_exec_ptr;
+
+   // Write the message to the dump buffer. Property tree is created only if the buffer records the message
+   schd_dump_buf_wret_t schd_msg_dump(
+         schd_dump_buf_c<boost_pt::ptree>& buf,
+         const schd_msg_c&                 msg );
+} // namespace schd
+
+#endif /* SCHD_CORE_INCLUDE_SCHD_MSG_H_ */
@@ -0,0 +1,191 @@
+/*
+ * schd_native.h
+ *
+ *  Description:
+ *    Declaration of the native simulation engine.
+ *    Execution blocks and common resources are modelled as plain data structures
+ *    which are updated by a single process from the calendar of the exec completions.
+ */
+
+#ifndef SCHD_CORE_INCLUDE_SCHD_NATIVE_H_
+#define SCHD_CORE_INCLUDE_SCHD_NATIVE_H_
+
+#include <vector>
+#include <string>
+#include <map>
+#include <memory>
+#include <utility>
+#include <boost/property_tree/ptree.hpp>
+#include <boost/optional.hpp>
+#include <boost/dynamic_bitset.hpp>
+#include <systemc>
+#include "schd_planner.h"
+#include "schd_cres_solver.h"
+#include "schd_msg.h"
+#include "schd_work.h"
+#include "schd_dump.h"
+
+// Short alias for the namespace
+namespace boost_pt = boost::property_tree;
+
+namespace schd {
+
+   SC_MODULE( schd_native_c ) { // declare module class
+
+   public:
+      // Constructor declaration
+      SC_CTOR( schd_native_c );
+
+      // Init declaration (to be used after the instantiation and before the simulation start)
+      void init(
+            boost::optional<const boost_pt::ptree&> _exec_p,      // exec section of the preferences
+            boost::optional<const boost_pt::ptree&> _cres_p,      // cres section of the preferences
+            boost::optional<const boost_pt::ptree&> _core_p,      // engine options
+            schd_planner_c&                         _plan );      // planner to be driven by the engine
+
+      void add_trace(
+            sc_core::sc_trace_file* tf,
+            const std::string& top_name );
+
+   private:
+      // Process declarations
+      void exec_thrd(
+            void );
+
+      typedef enum : unsigned char {
+         CRES_STATE_IDLE      = 0,  // Not connected to the exec
+         CRES_STATE_CONNECTED = 1,  //     Connected to the exec
+         CRES_STATE_WAIT_DCN  = 2,  // Waiting to be disconnected
+         CRES_STATE_WAIT_CON  = 3,  // Waiting to be    connected
+      } cres_state_t;
+
+      // State of the common resource as seen by the exec. Same as in schd_exec_c
+      class exec_cres_t {
+      public:
+         double       capacity    = 0.0;              // Common resource Capacity
+         bool         connected   = false;
+         cres_state_t state       = CRES_STATE_IDLE;  // Common resource is connected with the exec
+         double       cres_demand = 0.0;              // Total demand reported by the common resource
+         double       cres_load   = 0.0;              // Total load = cres_demand / capacity
+         double       plan_demand = 0.0;              // Demand which is requested for the exec from the planner
+         double       exec_demand = 0.0;              // Demand which is calculated by combining data from all the resources
+      };
+
+      class exec_data_t {
+      public:
+         std::string      name;
+         sc_core::sc_time time_upd   = sc_core::SC_ZERO_TIME;  // Time of the most recent update
+         sc_core::sc_time time_to_go = sc_core::SC_ZERO_TIME;  // Time to go after the last update
+         double           time_ext_coe = 1.0;                  // Time extension coefficient
+         schd_work_c      work;                                // Remaining work if the time is exact
+
+         std::size_t      thrd_id = 0;
+         std::size_t      task_id = 0;
+         std::string      param_id;
+
+         std::vector<exec_cres_t> cres_list;                   // Indexed by the cres index
+         std::size_t      job_hash = 0;
+
+         std::size_t      time_gen = 0;                        // Generation of the completion in the calendar
+         bool             complete = false;                    // Completion time has been reached
+
+         std::vector<schd_msg_plan_exec_ptr> plan_i;           // Input from the planner for the next delta
+         std::vector<schd_msg_plan_exec_ptr> plan_c;           //                    ... for the current delta
+         std::vector<schd_msg_cres_exec_ptr> cres_i;           // Input from cres for the next delta
+         std::vector<schd_msg_cres_exec_ptr> cres_c;           //             ... for the current delta
+
+         schd_dump_buf_c<boost_pt::ptree> *dump_buf_plan_i = NULL;
+         schd_dump_buf_c<boost_pt::ptree> *dump_buf_plan_o = NULL;
+         schd_dump_buf_c<boost_pt::ptree> *dump_buf_cres_i = NULL;
+         schd_dump_buf_c<boost_pt::ptree> *dump_buf_cres_o = NULL;
+      };
+
+      // State of the exec as seen by the common resource. Same as in schd_cres_c
+      class cres_exec_t {
+      public:
+         bool   connected = false;
+         double demand    = 0.0;
+      };
+
+      class cres_data_t {
+      public:
+         std::string name;
+         double      capacity = 0.0;
+         double      demand   = 0.0;
+
+         std::vector<cres_exec_t> exec_list;                   // Indexed by the exec index
+
+         std::vector<schd_msg_exec_cres_ptr> exec_i;           // Input from exec for the next delta
+         std::vector<schd_msg_exec_cres_ptr> exec_c;           //              ... for the current delta
+
+         schd_dump_buf_c<boost_pt::ptree> *dump_buf_exec_i = NULL;
+         schd_dump_buf_c<boost_pt::ptree> *dump_buf_exec_o = NULL;
+      };
+
+      // Blocks are indexed in the order of the preferences, which is the order of the xbar ports
+      // and the IDs in the messages.
+      // The order of the names is used where the modules iterate over their maps
+      std::vector<exec_data_t> exec_list;
+      std::vector<cres_data_t> cres_list;
+      std::vector<std::size_t> exec_ord;
+      std::vector<std::size_t> cres_ord;
+      typedef std::map<std::string, std::size_t> idx_map_t;
+      idx_map_t exec_idx_map;
+      idx_map_t cres_idx_map;
+
+      boost::optional<schd_planner_c&>    plan_p;
+      std::vector<schd_msg_exec_plan_ptr> plan_i;              // Input of the planner for the next delta
+      bool                                plan_act = false;    // Planner has input for the next delta
+
+      boost::dynamic_bitset<> exec_act;                        // Execs which have input for the next delta
+      boost::dynamic_bitset<> cres_act;                        // cres  which have input for the next delta
+
+      // Remaining work of the execs is accounted in the integer units instead of scaling time_to_go
+      bool               time_exact_en    = false;
+
+      // Contention between the execs is resolved by the centralized solver instead of the demand handshake
+      bool               cres_solver_en   = false;
+      bool               cres_solver_pend = false;   // Tasks have started or ended since the last solution
+      schd_cres_solver_c cres_solver;
+
+      void cres_solve(
+            void );
+
+      // Calendar of the exec completions: time -> (exec index, generation)
+      typedef std::multimap<sc_core::sc_time, std::pair<std::size_t, std::size_t>> calendar_t;
+      calendar_t calendar;
+
+      void plan_route(                                         // planner -> exec
+            const schd_msg_plan_exec_ptr& plan_msg );
+
+      void exec_proc(
+            std::size_t exec_idx );
+
+      void cres_proc(
+            std::size_t cres_idx );
+
+      void exec_send_cres(                                     // exec -> cres
+            exec_data_t& exec,
+            std::size_t  exec_idx,
+            const std::vector<std::size_t>& dst_list,
+            bool         connected,
+            double       demand );
+
+      void exec_send_plan(                                     // exec -> planner
+            exec_data_t& exec,
+            std::size_t  exec_idx );
+
+      void cres_send_exec(                                     // cres -> exec
+            cres_data_t& cres,
+            std::size_t  cres_idx,
+            const std::vector<std::size_t>& dst_list,
+            bool         connected );
+
+      void exec_schedule(                                      // (Re)schedule exec completion
+            exec_data_t& exec,
+            std::size_t  exec_idx );
+
+   }; // SC_MODULE( schd_native_c )
+} // namespace schd
+
+#endif /* SCHD_CORE_INCLUDE_SCHD_NATIVE_H_ */
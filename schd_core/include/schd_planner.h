@@ -11,11 +11,18 @@
 #include <vector>
 #include <string>
 #include <map>
+#include <list>
+#include <utility>
+#include <functional>
 #include <boost/property_tree/ptree.hpp>
 #include <boost/optional.hpp>
 #include <boost/regex.hpp>
+#include <boost/dynamic_bitset.hpp>
 #include <systemc>
 #include "schd_sig_ptree.h"
+#include "schd_fifo.h"
+#include "schd_msg.h"
+#include "schd_dump.h"
 
 // Short alias for the namespace
 namespace boost_pt = boost::property_tree;
@@ -25,9 +32,9 @@ namespace schd {
    SC_MODULE( schd_planner_c ) { // declare module class
 
    public:
-      // Module I/O Ports
-      sc_core::sc_port<sc_core::sc_fifo_in_if <schd_sig_ptree_c>> core_i;
-      sc_core::sc_port<sc_core::sc_fifo_out_if<schd_sig_ptree_c>> core_o;
+      // Module I/O Ports. Not bound when the planner is driven by the native engine
+      sc_core::sc_port<schd_fifo_in_if<schd_sig_ptree_c>, 1, sc_core::SC_ZERO_OR_MORE_BOUND> core_i;
+      sc_core::sc_port<sc_core::sc_fifo_out_if<schd_sig_ptree_c>, 1, sc_core::SC_ZERO_OR_MORE_BOUND> core_o;
 
       // Constructor declaration
       SC_CTOR( schd_planner_c );
@@ -36,13 +43,32 @@ namespace schd {
       void init(
             boost::optional<const boost_pt::ptree&> _thrd_p,   // Threads
             boost::optional<const boost_pt::ptree&> _task_p,   // Tasks
-            boost::optional<const boost_pt::ptree&> _exec_p ); // execution units
+            boost::optional<const boost_pt::ptree&> _exec_p,   // execution units
+            boost::optional<const boost_pt::ptree&> _core_p ); // engine options
+
+      friend class schd_native_c; // Native engine calls the processing steps directly
 
    private:
       // Process declarations
       void exec_thrd(
             void );
 
+      // Processing steps of the planner
+      void plan_update(                                     // Start the threads and allocate execs
+            void );
+
+      void plan_complete(                                   // Process completion message from the exec
+            const schd_msg_exec_plan_t& core_msg_inp );
+
+      void plan_write(                                      // Send configuration to the exec
+            const schd_msg_plan_exec_ptr& plan_msg );
+
+      // Output to the native engine. Ports are used if empty
+      std::function<void( const schd_msg_plan_exec_ptr& )> plan_write_f;
+
+      schd_dump_buf_c<boost_pt::ptree> dump_buf_core_i;
+      schd_dump_buf_c<boost_pt::ptree> dump_buf_core_o;
+
       // Forward declarations
       class task_data_t;
       typedef std::map<std::string, task_data_t> task_list_t;
@@ -51,11 +77,20 @@ namespace schd {
       typedef std::map<std::string, thrd_data_t> thrd_list_t;
 
       class event_data_t;
-      typedef std::list<event_data_t> event_reg_t;
+      typedef std::vector<event_data_t> event_reg_t;
+
+      // Reference to the slot in the event register
+      class event_ref_t {
+      public:
+         std::size_t slot = 0;   // Index of the slot in the register
+         std::size_t gen  = 0;   // Generation of the slot at the time of the reference
+      };
 
       // List of the execution blocks
       class exec_data_t {
       public:
+         std::size_t idx = 0;                                     // Index in the exec list
+         std::size_t id  = 0;                                     // ID in the messages
          boost::optional<const thrd_list_t::value_type&> thrd_p;  // Caller thread.
          boost::optional<const task_list_t::value_type&> task_p;  // Caller task. "" means the exec is free
          boost::optional<const boost_pt::ptree&>         param_p; // parameters
@@ -69,15 +104,18 @@ namespace schd {
       class task_run_el_t {
       public:
          boost::regex        mask_exec;
+         boost::dynamic_bitset<> exec_bits;   // Indexes of the execs matching the mask
          boost_pt::ptree     options;
          std::vector<double> cres_demand;
       };
 
       class task_data_t {
       public:
+         std::size_t                id = 0;          // ID in the messages
          sc_core::sc_time           run_time = sc_core::SC_ZERO_TIME;
          std::vector<task_run_el_t> run_list;
          std::vector<std::string>   cres_list;
+         std::vector<std::size_t>   cres_id_list;    // IDs of the common resources in the messages
       };
 
       // thread list
@@ -86,6 +124,7 @@ namespace schd {
          std::string                                     name = "";
          boost::optional<const task_list_t::value_type&> task_p;        // Also used as a task/event flag
          boost_pt::ptree                                 task_param;
+         std::size_t                                     evnt_id = 0;   // Event ID (index in the event name list)
       };
 
       typedef enum {
@@ -96,14 +135,18 @@ namespace schd {
 
       class thrd_data_t {
       public:
+         std::size_t                id = 0;                           // ID in the messages
          double                     priority = 0.0;                   // priority of the called instance in this thread
          std::vector<boost::regex>  mask_evnt_list;                   // "and" list of start event masks
+         std::vector<boost::dynamic_bitset<>> mask_evnt_bits;         // Event IDs matching each of the start event masks
+         boost::dynamic_bitset<>    mask_evnt_any;                    // Event IDs matching any of the start event masks
+         std::size_t                idx = 0;                          // Index in the thread list
          std::vector<thrd_seq_el_t> seq_list;                         // sequence of calls
          std::size_t                seq_idx = 0;                      // index in the sequence list
          thrd_seq_el_state_t        seq_state = SEQ_STATE_IDLE;       // State of the sequence list processing
 
          // list of events which started this thread
-         std::list<boost::optional<      event_reg_t::value_type&>> evnt_list;
+         std::vector<event_ref_t>   evnt_list;
 
          // list of the execution blocks which are processing this thread
          std::list<boost::optional<const exec_list_t::value_type&>> exec_list;
@@ -112,47 +155,119 @@ namespace schd {
       // event register
       class event_data_t {
       public:
-         // event and thread name
-         boost::optional<const std::string&>              name_p;
+         // event ID and thread name
+         std::size_t                                      name_id = 0;
          boost::optional<const thrd_list_t::value_type&>  thrd_caller;
 
          // event occurrence time
          sc_core::sc_time  time = sc_core::SC_ZERO_TIME;
 
-         // list of the threads which were started with this event
-         std::list<boost::optional<const thrd_list_t::value_type&>> thrd_run_list;
+         // threads which were started with this event
+         boost::dynamic_bitset<> thrd_run_bits;
+         std::size_t thrd_run_cntr = 0;
 
          // number of the threads which were started with this event and finished
          std::size_t thrd_end_cntr = 0;
 
-         // list of the threads which don't use this event name
-         std::list<boost::optional<const thrd_list_t::value_type&>> thrd_msm_list;
+         std::size_t seq  = 0;      // registration order
+         std::size_t gen  = 0;      // generation of the slot. Incremented when the slot is released
+         bool        used = false;  // slot is occupied
 
-         bool remove = false;
+         std::list<std::size_t>::iterator bucket_it; // position in the bucket of the event ID
       };
 
-      event_reg_t event_reg;
+      event_reg_t event_reg;                                // slot array of the event register
+      std::vector<std::size_t> event_free;                  // free slots in the register
+      std::vector<std::size_t> event_done;                  // slots to check at the next end of a thread
+      std::vector<std::list<std::size_t>> event_bucket;     // occupied slots for each event ID in the order of registration
+      std::size_t event_seq = 0;                            // registration counter
+
+      std::size_t event_add(
+            std::size_t name_id );
+
+      void event_cleanup(
+            void );
+
+      event_data_t& event_get(
+            const event_ref_t& ref );
+
       exec_list_t exec_list;
       task_list_t task_list;
       thrd_list_t thrd_list;
 
+      // List of the event names which can be generated by the threads. Index in the list is the event ID
+      std::vector<std::string> evnt_name_list;
+
+      // Threads which can be started by each event ID
+      std::vector<boost::dynamic_bitset<>> evnt_thrd_bits;
+
+      // Threads and execs in the order of the lists
+      std::vector<boost::optional<thrd_list_t::value_type&>> thrd_vect;
+      std::vector<boost::optional<exec_list_t::value_type&>> exec_vect;
+      std::vector<boost::optional<exec_list_t::value_type&>> exec_id_vect;  // Execs indexed by the ID in the messages
+
+      boost::dynamic_bitset<> thrd_dirty;  // Threads which need to be checked against the new events
+      boost::dynamic_bitset<> exec_free;   // Free execs
+      bool                    alloc_pend = false; // Waiting list or free execs have changed since the last allocation
+
+      // Engine which maps the masks to the values in and_list()
+      typedef enum {
+         ALLOC_GREEDY   = 0,  // Greedy heuristic. Takes the mask with the least number of matches first
+         ALLOC_MATCHING = 1   // Exact maximum bipartite matching (Hopcroft-Karp)
+      } alloc_mode_t;
+
+      alloc_mode_t alloc_mode = ALLOC_GREEDY;
+
       bool and_list(
-            std::vector<boost::optional<const boost::regex&>>& msk,  // regex masks
-            std::vector<boost::optional<const std::string&>>&  val,  // check values
+            const std::vector<boost::dynamic_bitset<>>& mat,         // match matrix: row for each mask, bit for each value
+            std::size_t val_size,                                    // number of check values
             std::vector<std::size_t>& msk_val_map,                   // matching value for each mask
             std::vector<std::size_t>& val_msk_cnt );                 // Number of masks matching each value
 
+      bool and_list_greedy(
+            const std::vector<boost::dynamic_bitset<>>& mat,
+            std::size_t val_size,
+            std::vector<std::size_t>& msk_val_map );
+
+      bool and_list_match(
+            const std::vector<boost::dynamic_bitset<>>& mat,
+            std::size_t val_size,
+            std::vector<std::size_t>& msk_val_map );
+
+      bool and_list_path(                                            // Augmenting path search for and_list_match()
+            const std::vector<boost::dynamic_bitset<>>& mat,
+            std::size_t msk_idx,
+            std::vector<std::size_t>& msk_val_map,
+            std::vector<std::size_t>& val_msk_map,
+            std::vector<std::size_t>& msk_dist );
+
       // processing wait list
       class wait_data_t {
       public:
-         double priority;
          boost::optional<      thrd_list_t::value_type&> thrd_p;
          boost::optional<const task_list_t::value_type&> task_p;
          std::size_t mask_exec_base = 0;
          std::size_t mask_exec_size = 0;
       };
 
-      typedef std::list<wait_data_t> wait_list_t;
+      // Wait list key: thread priority and sequence number of the arrival to the list
+      typedef std::pair<double, std::size_t> wait_key_t;
+
+      // Descending priority first, then the order of arrival
+      class wait_key_cmp_t {
+      public:
+         bool operator()( const wait_key_t& lhs, const wait_key_t& rhs ) const {
+            return ( lhs.first >  rhs.first ) ||
+                   ( lhs.first == rhs.first && lhs.second < rhs.second );
+         }
+      };
+
+      typedef std::map<wait_key_t, wait_data_t, wait_key_cmp_t> wait_list_t;
+      wait_list_t wait_list;
+      std::size_t wait_seq = 0;
+
+      void wait_list_add(
+            thrd_list_t::value_type& thrd_el );
    }; // SC_MODULE( schd_planner_c )
 } // namespace schd
 
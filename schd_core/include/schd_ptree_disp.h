@@ -0,0 +1,61 @@
+/*
+ * schd_ptree_disp.h
+ *
+ *  Description:
+ *    Declaration of the system component: ptree dispatch table.
+ *    Used by the direct interconnect instead of the cross bar. Producers write
+ *    the messages straight into the input FIFO of the destination, there is no
+ *    process and no intermediate FIFO between the blocks
+ */
+
+#ifndef SCHD_CORE_INCLUDE_SCHD_PTREE_DISP_H_
+#define SCHD_CORE_INCLUDE_SCHD_PTREE_DISP_H_
+
+#include <vector>
+#include <systemc>
+#include "schd_sig_ptree.h"
+#include "schd_fifo.h"
+
+namespace schd {
+
+   class schd_ptree_disp_c
+      : public sc_core::sc_object
+      , public sc_core::sc_fifo_out_if<schd_sig_ptree_c> {
+
+   public:
+      explicit schd_ptree_disp_c(
+            const char* nm );
+
+      // Add destination. Destination ID of the typed messages is the order of the calls
+      void add_dst(
+            schd_fifo_c<schd_sig_ptree_c>& dst );
+
+      // sc_fifo_out_if. Any number of the producer ports can be bound to the table
+      void write(
+            const schd_sig_ptree_c& sig );
+
+      bool nb_write(
+            const schd_sig_ptree_c& sig );
+
+      int num_free(
+            void ) const;
+
+      const sc_core::sc_event& data_read_event(
+            void ) const;
+
+   private:
+      std::vector<schd_fifo_c<schd_sig_ptree_c>*> dst_list;
+
+      // Epoch of the last check of each destination. Detects duplicate destinations in a message
+      std::vector<std::size_t> dst_epoch;
+      std::size_t              dst_epoch_cur = 0;
+
+      // Check destinations of the message. Returns single destination or the typed message destinations
+      const std::vector<std::size_t>& dst_check(
+            const schd_sig_ptree_c& sig );
+
+      const std::vector<std::size_t> dst_single = std::vector<std::size_t>( 1, 0 );
+   }; // class schd_ptree_disp_c
+} // namespace schd
+
+#endif /* SCHD_CORE_INCLUDE_SCHD_PTREE_DISP_H_ */
@@ -10,11 +10,13 @@
 
 #include <vector>
 #include <string>
+#include <unordered_map>
 #include <boost/property_tree/ptree.hpp>
 #include <boost/optional.hpp>
 #include <boost/regex.hpp>
 #include <systemc>
 #include "schd_sig_ptree.h"
+#include "schd_fifo.h"
 #include "schd_dump.h"
 
 // Short alias for the namespace
@@ -26,7 +28,7 @@ namespace schd {
 
    public:
       // Module I/O Ports
-      sc_core::sc_vector<sc_core::sc_port<sc_core::sc_fifo_in_if <schd_sig_ptree_c>>> vi;
+      sc_core::sc_vector<sc_core::sc_port<schd_fifo_in_if<schd_sig_ptree_c>>> vi;
       sc_core::sc_vector<sc_core::sc_port<sc_core::sc_fifo_out_if<schd_sig_ptree_c>>> vo;
 
       // Constructor declaration
@@ -38,9 +40,12 @@ namespace schd {
 
    private:
       // Process declarations
-      void exec_thrd(
+      void exec_meth(
             void );
 
+      sc_core::sc_event_or_list     vi_or_list;     // Events of all the input ports. Created once
+      std::vector<schd_sig_ptree_c> sig_inp_list;   // Batch of the input signals
+
       class port_map_t {
       public:
          bool         regex = false;
@@ -54,6 +59,18 @@ namespace schd {
       std::vector<port_map_t> vi_map;
       std::vector<port_map_t> vo_map;
 
+      // Destination name -> output index. Names of the outputs are resolved in init().
+      // Other names which match the masks are added on the first use
+      typedef std::unordered_map<std::string, std::size_t> dst_idx_map_t;
+      dst_idx_map_t dst_idx_map;
+
+      std::size_t dst_find(
+            const std::string& dst_name );
+
+      // Epoch of the last write to each output. Detects duplicate destinations in a message
+      std::vector<std::size_t> dst_epoch;
+      std::size_t              dst_epoch_cur = 0;
+
    }; // SC_MODULE( schd_ptree_xbar_c )
 } // namespace schd
 
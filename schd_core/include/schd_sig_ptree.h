@@ -4,6 +4,10 @@
  *  Description:
  *    Declaration of the signal which carries a generic property tree
  *    This signal is used as a universal transport between blocks
+ *    The signal can carry a typed message instead of the property tree. In this case
+ *    the property tree is created from the message on the first access
+ *    Payloads are immutable and shared between the copies of the signal
+ *    Hash of the payload is calculated only for the signals which are traced
  */
 
 #ifndef SCHD_CORE_INCLUDE_SCHD_SIG_PTREE_H_
@@ -11,8 +15,10 @@
 
 #include <string>
 #include <iostream>
+#include <memory>
 #include <boost/property_tree/ptree.hpp>
 #include <systemc>
+#include "schd_msg.h"
 
 // Short alias for the namespace
 namespace boost_pt = boost::property_tree;
@@ -37,10 +43,28 @@ namespace schd {
 
    class schd_sig_ptree_c {
    private:
-      boost_pt::ptree data;
-      std::size_t     data_hash = 0;
+      typedef std::shared_ptr<const boost_pt::ptree> data_ptr_t;
+
+      mutable data_ptr_t data_p;                   // Property tree. Created from msg_p on the first access
+      schd_msg_ptr       msg_p;                    // Typed message
+
+      std::size_t        data_hash  = 0;
+      bool               hash_valid = true;        // data_hash corresponds to the payload
+      mutable bool       trace_en   = false;       // Signal is registered with a trace file. Not copied
+
+      void hash_update(                            // Update hash if the signal is traced
+            void );
 
    public:
+      schd_sig_ptree_c(
+            void ) = default;
+
+      schd_sig_ptree_c(
+            const schd_sig_ptree_c& rhs );
+
+      schd_sig_ptree_c(
+            schd_sig_ptree_c&& rhs );
+
       // Required for the assignment operations
       schd_sig_ptree_c& set(
             const boost_pt::ptree& rhs ); // Set from property tree rhs
@@ -48,17 +72,42 @@ namespace schd {
       schd_sig_ptree_c& set(
             const std::string& rhs );     // Set from json string rhs
 
+      schd_sig_ptree_c& set(
+            const std::shared_ptr<const boost_pt::ptree>& rhs ); // Share property tree rhs
+
+      schd_sig_ptree_c& set(
+            const schd_msg_ptr& rhs );    // Set from typed message rhs
+
       const boost_pt::ptree& get(
             void ) const;
 
+      // Typed message. Empty if the signal carries a property tree
+      const schd_msg_ptr& msg(
+            void ) const;
+
+      // Typed message of the expected type. NULL if the signal carries a different type
+      template <class M>
+      std::shared_ptr<const M> msg_as(
+            void ) const {
+         return std::dynamic_pointer_cast<const M>( msg_p );
+      }
+
       // Required by sc_signal<> and sc_fifo<>
       schd_sig_ptree_c& operator = (
             const schd_sig_ptree_c& rhs );
 
+      // Required by schd_fifo_c<>. Payload is moved without the reference counting
+      schd_sig_ptree_c& operator = (
+            schd_sig_ptree_c&& rhs );
+
       // Required by sc_signal<>
       bool operator == (
             const schd_sig_ptree_c& rhs) const;
 
+      // Hash of the payload
+      std::size_t hash(
+            void ) const;
+
       friend void sc_core::sc_trace(
             sc_core::sc_trace_file* tf,
             const schd_sig_ptree_c& sig,
@@ -0,0 +1,80 @@
+/*
+ * schd_work.h
+ *
+ *  Description:
+ *    Integer accounting of the remaining work of the execution block.
+ *    Work is kept in integer units: 1/SPEED_ONE of the time resolution tick at the full speed.
+ *    Time extension coefficient is quantised once per change to the fixed point SPEED_ONE / speed.
+ *    The relative error of the speed is below 0.5 / speed, i.e. 2^-49 of the coefficient.
+ *    Progress between the updates and the completion tick are then calculated in the integers,
+ *    so the same coefficients give the same completion ticks in every run and in every engine
+ */
+
+#ifndef SCHD_CORE_INCLUDE_SCHD_WORK_H_
+#define SCHD_CORE_INCLUDE_SCHD_WORK_H_
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <systemc>
+#include "schd_report.h"
+
+namespace schd {
+
+   class schd_work_c {
+   public:
+      static const int           SPEED_BITS = 48;
+      static const std::uint64_t SPEED_ONE  = std::uint64_t( 1 ) << SPEED_BITS; // Speed without the time extension
+
+      // Start new work at the current time
+      void start(
+            const sc_core::sc_time& runtime ) {
+         work_left = static_cast<work_t>( runtime.value()) << SPEED_BITS;
+         speed     = SPEED_ONE;
+         time_upd  = sc_core::sc_time_stamp();
+      } // start(
+
+      // Account the progress at the old speed and change the speed. Returns time to go from now
+      sc_core::sc_time ext_set(
+            double time_ext_coe ) {
+         const sc_core::sc_time& time_now = sc_core::sc_time_stamp();
+         work_t                  work_done = static_cast<work_t>(( time_now - time_upd ).value()) * speed;
+
+         work_left = ( work_done < work_left ) ? work_left - work_done : 0;
+         time_upd  = time_now;
+
+         // Coefficient is quantised once per change. Same load always gives the same speed
+         double speed_new = std::nearbyint( std::ldexp( 1.0 / std::max( time_ext_coe, 1.0 ), SPEED_BITS ));
+
+         if( speed_new < 1.0 ) {
+            SCHD_REPORT_ERROR( "schd::work" ) << " Time extension is out of range: " << time_ext_coe;
+         }
+
+         speed = std::max( static_cast<std::uint64_t>( speed_new ), std::uint64_t( 1 ));
+
+         return time_to_go();
+      } // ext_set(
+
+      // Time to go from the most recent update. Rounded up to the next tick
+      sc_core::sc_time time_to_go(
+            void ) const {
+         work_t ticks = ( work_left + speed - 1 ) / speed;
+
+         if( ticks > std::numeric_limits<std::uint64_t>::max()) {
+            SCHD_REPORT_ERROR( "schd::work" ) << " Time to go is out of range";
+         }
+
+         return sc_core::sc_time::from_value( static_cast<std::uint64_t>( ticks ));
+      } // time_to_go(
+
+   private:
+      __extension__ typedef unsigned __int128 work_t;  // Up to 2^64 ticks of the runtime at SPEED_ONE
+
+      work_t           work_left = 0;                      // Work units to go after the most recent update
+      std::uint64_t    speed     = SPEED_ONE;              // Work units per tick
+      sc_core::sc_time time_upd  = sc_core::SC_ZERO_TIME;  // Time of the most recent update
+   }; // class schd_work_c
+} // namespace schd
+
+#endif /* SCHD_CORE_INCLUDE_SCHD_WORK_H_ */
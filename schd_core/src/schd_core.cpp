@@ -22,18 +22,43 @@ schd_core_c::schd_core_c(
    : sc_core::sc_module( nm )
    , plan_ei( "plan_ei" )
    , plan_eo( "plan_eo" )
-   , chn_core_plan( "chn_core_plan", chn_core_plan_size )
-   , chn_plan_core( "chn_plan_core", chn_plan_core_size )
+   , chn_core_plan( "chn_core_plan" )
+   , chn_plan_core( "chn_plan_core" )
    , mux_plan_exec( "mux_plan_exec" )
    , mux_exec_plan( "mux_exec_plan" )
    , mux_cres_exec( "mux_cres_exec" )
-   , mux_exec_cres( "mux_exec_cres" ) {
+   , mux_exec_cres( "mux_exec_cres" )
+   , disp_plan_exec( "disp_plan_exec" )
+   , disp_exec_plan( "disp_exec_plan" )
+   , disp_cres_exec( "disp_cres_exec" )
+   , disp_exec_cres( "disp_exec_cres" ) {
 
 } // schd_core_c::schd_core_c(
 
 void schd_core_c::init(
       boost::optional<const boost_pt::ptree&> _exec_p,
-      boost::optional<const boost_pt::ptree&> _cres_p ) {
+      boost::optional<const boost_pt::ptree&> _cres_p,
+      boost::optional<const boost_pt::ptree&> _core_p ) {
+
+   // Interconnect between the planner, exec and cres blocks
+   if( _core_p.is_initialized()) {
+      boost::optional<std::string> interconnect_p = _core_p.get().get_optional<std::string>("interconnect");
+
+      if( !interconnect_p.is_initialized() || interconnect_p.get() == "xbar" ) {
+         direct_en = false;
+      }
+      else if( interconnect_p.get() == "direct" ) {
+         direct_en = true;
+      }
+      else {
+         SCHD_REPORT_ERROR( "schd::core" ) << name() << " Unsupported interconnect: " << interconnect_p.get();
+      }
+
+      chn_size = chn_size_get( _core_p.get());
+   }
+
+   chn_core_plan.reserve( chn_size );
+   chn_plan_core.reserve( chn_size );
 
    boost_pt::ptree endpoint_pt;
    boost_pt::ptree exec_list_pt;
@@ -45,6 +70,9 @@ void schd_core_c::init(
    endpoint_pt.put( "dump", "" ); // don't dump inside xbars
    plan_list_pt.push_back( std::make_pair( "", endpoint_pt ));
 
+   std::shared_ptr<const schd_exec_c::cres_cap_list_t>  cres_cap_p  = cres_cap_get( _cres_p.get());
+   std::shared_ptr<const schd_exec_c::cres_rank_list_t> cres_rank_p = cres_rank_get( _cres_p.get());
+
    // Create exec instances and the corresponding channels
    BOOST_FOREACH( const boost_pt::ptree::value_type& exec_el, _exec_p.get()) {
       if( !exec_el.first.empty()) {
@@ -64,32 +92,41 @@ void schd_core_c::init(
 
       exec_info.idx    = std::distance( exec_list.begin(), exec_list.end() );
       exec_info.pref_p = boost::optional<const boost_pt::ptree&>( exec_el.second );
+      exec_info.chn_size = chn_size_get( exec_el.second );
 
       schd_exec_c *exec_ptr = new schd_exec_c( name_p.get().c_str() );
       exec_info.mod_p  = boost::optional<schd_exec_c&>( *exec_ptr );
 
-      exec_info.mod_p.get().init( exec_info.pref_p, _cres_p ); // Initialize exec
+      exec_info.mod_p.get().init( exec_info.pref_p, cres_cap_p, cres_rank_p, _core_p ); // Initialize exec
 
-      sc_core::sc_fifo<schd_sig_ptree_c> *fifo_ptr;
-      fifo_ptr = new sc_core::sc_fifo<schd_sig_ptree_c>(
+      schd_fifo_c<schd_sig_ptree_c> *fifo_ptr;
+      fifo_ptr = new schd_fifo_c<schd_sig_ptree_c>(
             std::string( name_p.get() + "_plan_exec" ).c_str(),
-            exec_info.chn_plan_exec_size );
-      exec_info.chn_plan_exec_p = boost::optional<sc_core::sc_fifo<schd_sig_ptree_c>&>( *fifo_ptr );
-
-      fifo_ptr = new sc_core::sc_fifo<schd_sig_ptree_c>(
-            std::string( name_p.get() + "_exec_plan" ).c_str(),
-            exec_info.chn_exec_plan_size );
-      exec_info.chn_exec_plan_p = boost::optional<sc_core::sc_fifo<schd_sig_ptree_c>&>( *fifo_ptr );
+            exec_info.chn_size );
+      exec_info.chn_plan_exec_p = boost::optional<schd_fifo_c<schd_sig_ptree_c>&>( *fifo_ptr );
 
-      fifo_ptr = new sc_core::sc_fifo<schd_sig_ptree_c>(
+      fifo_ptr = new schd_fifo_c<schd_sig_ptree_c>(
             std::string( name_p.get() + "_cres_exec" ).c_str(),
-            exec_info.chn_cres_exec_size );
-      exec_info.chn_cres_exec_p = boost::optional<sc_core::sc_fifo<schd_sig_ptree_c>&>( *fifo_ptr );
+            exec_info.chn_size );
+      exec_info.chn_cres_exec_p = boost::optional<schd_fifo_c<schd_sig_ptree_c>&>( *fifo_ptr );
 
-      fifo_ptr = new sc_core::sc_fifo<schd_sig_ptree_c>(
-            std::string( name_p.get() + "_exec_cres" ).c_str(),
-            exec_info.chn_exec_cres_size );
-      exec_info.chn_exec_cres_p = boost::optional<sc_core::sc_fifo<schd_sig_ptree_c>&>( *fifo_ptr );
+      if( direct_en ) {
+         // Inputs of the exec are the destinations of the dispatch tables. Index is the order of the preferences
+         disp_plan_exec.add_dst( exec_info.chn_plan_exec_p.get());
+         disp_cres_exec.add_dst( exec_info.chn_cres_exec_p.get());
+      }
+      else {
+         // Outputs of the exec are connected to the xbars
+         fifo_ptr = new schd_fifo_c<schd_sig_ptree_c>(
+               std::string( name_p.get() + "_exec_plan" ).c_str(),
+               exec_info.chn_size );
+         exec_info.chn_exec_plan_p = boost::optional<schd_fifo_c<schd_sig_ptree_c>&>( *fifo_ptr );
+
+         fifo_ptr = new schd_fifo_c<schd_sig_ptree_c>(
+               std::string( name_p.get() + "_exec_cres" ).c_str(),
+               exec_info.chn_size );
+         exec_info.chn_exec_cres_p = boost::optional<schd_fifo_c<schd_sig_ptree_c>&>( *fifo_ptr );
+      }
 
       // Update list
       exec_list.emplace( std::make_pair( name_p.get(), exec_info ));
@@ -119,22 +156,30 @@ void schd_core_c::init(
 
       cres_info.idx    = std::distance( cres_list.begin(), cres_list.end() );
       cres_info.pref_p = boost::optional<const boost_pt::ptree&>( cres_el.second );
+      cres_info.chn_size = chn_size_get( cres_el.second );
 
       schd_cres_c *cres_ptr = new schd_cres_c( name_p.get().c_str() );
       cres_info.mod_p  = boost::optional<schd_cres_c&>( *cres_ptr );
 
-      cres_info.mod_p.get().init( cres_info.pref_p, _exec_p ); // Initialize cres
-
-      sc_core::sc_fifo<schd_sig_ptree_c> *fifo_ptr;
-      fifo_ptr = new sc_core::sc_fifo<schd_sig_ptree_c>(
-            std::string( name_p.get() + "_cres_exec" ).c_str(),
-            cres_info.chn_cres_exec_size );
-      cres_info.chn_cres_exec_p = boost::optional<sc_core::sc_fifo<schd_sig_ptree_c>&>( *fifo_ptr );
+      cres_info.mod_p.get().init( cres_info.pref_p, _exec_p, _core_p ); // Initialize cres
 
-      fifo_ptr = new sc_core::sc_fifo<schd_sig_ptree_c>(
+      schd_fifo_c<schd_sig_ptree_c> *fifo_ptr;
+      fifo_ptr = new schd_fifo_c<schd_sig_ptree_c>(
             std::string( name_p.get() + "_exec_cres" ).c_str(),
-            cres_info.chn_exec_cres_size );
-      cres_info.chn_exec_cres_p = boost::optional<sc_core::sc_fifo<schd_sig_ptree_c>&>( *fifo_ptr );
+            cres_info.chn_size );
+      cres_info.chn_exec_cres_p = boost::optional<schd_fifo_c<schd_sig_ptree_c>&>( *fifo_ptr );
+
+      if( direct_en ) {
+         // Input of the cres is the destination of the dispatch table. Index is the order of the preferences
+         disp_exec_cres.add_dst( cres_info.chn_exec_cres_p.get());
+      }
+      else {
+         // Output of the cres is connected to the xbar
+         fifo_ptr = new schd_fifo_c<schd_sig_ptree_c>(
+               std::string( name_p.get() + "_cres_exec" ).c_str(),
+               cres_info.chn_size );
+         cres_info.chn_cres_exec_p = boost::optional<schd_fifo_c<schd_sig_ptree_c>&>( *fifo_ptr );
+      }
 
       // Update list
       cres_list.emplace( std::make_pair( name_p.get(), cres_info ));
@@ -145,6 +190,99 @@ void schd_core_c::init(
       cres_list_pt.push_back( std::make_pair( "", endpoint_pt ));
    } // BOOST_FOREACH( const boost_pt::ptree::value_type& cres_el, _cres_p.get())
 
+   if( direct_en ) {
+      init_direct();
+   }
+   else {
+      init_xbar(
+            plan_list_pt,
+            exec_list_pt,
+            cres_list_pt );
+   }
+
+   // exec trace
+   BOOST_FOREACH( const exec_list_t::value_type& exec_info, exec_list ) {
+      exec_info.second.mod_p.get().add_trace( schd_trace.tf, name());
+   }
+
+   // cres trace
+   BOOST_FOREACH( const cres_list_t::value_type& cres_info, cres_list ) {
+      cres_info.second.mod_p.get().add_trace( schd_trace.tf, name());
+   }
+} // schd_core_c::init(
+
+// Initial size of the channels: fifo_size of the block, or of the core by default
+std::size_t schd_core_c::chn_size_get(
+      const boost_pt::ptree& pref ) {
+   boost::optional<int> size_p = pref.get_optional<int>("fifo_size");
+
+   if( !size_p.is_initialized()) {
+      return chn_size;
+   }
+   else if( size_p.get() <= 0 ) {
+      SCHD_REPORT_ERROR( "schd::core" ) << name() << " Incorrect fifo_size: " << size_p.get();
+   }
+
+   return size_p.get();
+} // schd_core_c::chn_size_get(
+
+std::shared_ptr<const schd_exec_c::cres_cap_list_t> schd_core_c::cres_cap_get(
+      const boost_pt::ptree& cres_pt ) {
+   std::shared_ptr<schd_exec_c::cres_cap_list_t> cap_list_p =
+         std::make_shared<schd_exec_c::cres_cap_list_t>( schd_msg_ids.cres_size(), 0.0 );
+
+   BOOST_FOREACH( const boost_pt::ptree::value_type& cres_el, cres_pt ) {
+      if( !cres_el.first.empty()) {
+         SCHD_REPORT_ERROR( "schd::core" ) << name() <<  " Incorrect cres structure";
+      }
+
+      boost::optional<std::string> cres_name_p = cres_el.second.get_optional<std::string>("name");
+      boost::optional<double>      cres_cap_p  = cres_el.second.get_optional<double>("capacity");
+
+      if( !cres_name_p.is_initialized() ||
+          !cres_cap_p.is_initialized()) {
+         SCHD_REPORT_ERROR( "schd::core" ) << name() <<  " Incorrect cres structure";
+      }
+
+      if( cres_cap_p.get() <= 0.0 ) {
+         SCHD_REPORT_ERROR( "schd::core" ) << name() << " Incorrect capacity specification";
+      }
+
+      cap_list_p->at( schd_msg_ids.cres_id( cres_name_p.get())) = cres_cap_p.get();
+   } // BOOST_FOREACH( const boost_pt::ptree::value_type& cres_el, cres_pt )
+
+   return cap_list_p;
+} // schd_core_c::cres_cap_get(
+
+std::shared_ptr<const schd_exec_c::cres_rank_list_t> schd_core_c::cres_rank_get(
+      const boost_pt::ptree& cres_pt ) {
+   std::shared_ptr<schd_exec_c::cres_rank_list_t> rank_list_p =
+         std::make_shared<schd_exec_c::cres_rank_list_t>( schd_msg_ids.cres_size(), 0 );
+
+   // IDs in the order of the names. The structure is checked by cres_cap_get
+   typedef std::map<std::string, std::size_t> cres_id_map_t;
+   cres_id_map_t cres_id_map;
+
+   BOOST_FOREACH( const boost_pt::ptree::value_type& cres_el, cres_pt ) {
+      const std::string cres_name = cres_el.second.get<std::string>("name");
+
+      cres_id_map.emplace( std::make_pair( cres_name, schd_msg_ids.cres_id( cres_name )));
+   }
+
+   std::size_t cres_rank = 0;
+
+   BOOST_FOREACH( const cres_id_map_t::value_type& cres_id_el, cres_id_map ) {
+      rank_list_p->at( cres_id_el.second ) = cres_rank ++;
+   }
+
+   return rank_list_p;
+} // schd_core_c::cres_rank_get(
+
+void schd_core_c::init_xbar(
+      const boost_pt::ptree& plan_list_pt,
+      const boost_pt::ptree& exec_list_pt,
+      const boost_pt::ptree& cres_list_pt ) {
+
    // Initilaize MUX instances
    boost_pt::ptree mux_pt;
 
@@ -212,16 +350,41 @@ void schd_core_c::init(
 
       //SCHD_REPORT_INFO( "schd::core" ) << name() <<  " Processed: " << cres_info.first;
    } // BOOST_FOREACH( const cres_list_t::value_type& cres_info, cres_list )
+} // schd_core_c::init_xbar(
+
+void schd_core_c::init_direct(
+      void ) {
+
+   // Planner is the only destination of exec -> plan
+   disp_exec_plan.add_dst( chn_core_plan );
 
-   // exec trace
    BOOST_FOREACH( const exec_list_t::value_type& exec_info, exec_list ) {
-      exec_info.second.mod_p.get().add_trace( schd_trace.tf, name());
-   }
+      // exec.plan_o -> disp_exec_plan -> chn_core_plan
+      exec_info.second.mod_p.get().plan_o.bind( disp_exec_plan );
+
+      // disp_plan_exec -> chn_plan_exec -> exec.plan_i
+      exec_info.second.mod_p.get().plan_i.bind( exec_info.second.chn_plan_exec_p.get() );
+
+      // exec.cres_o -> disp_exec_cres -> chn_exec_cres[]
+      exec_info.second.mod_p.get().cres_o.bind( disp_exec_cres );
+
+      // disp_cres_exec -> chn_cres_exec -> exec.cres_i
+      exec_info.second.mod_p.get().cres_i.bind( exec_info.second.chn_cres_exec_p.get() );
+   } // BOOST_FOREACH( const exec_list_t::value_type exec_el, exec_list )
+
+   // core.plan_eo -> disp_plan_exec -> chn_plan_exec[]
+   plan_eo.bind( disp_plan_exec );
+
+   // chn_core_plan -> core.plan_ei
+   plan_ei.bind( chn_core_plan );
 
-   // cres trace
    BOOST_FOREACH( const cres_list_t::value_type& cres_info, cres_list ) {
-      cres_info.second.mod_p.get().add_trace( schd_trace.tf, name());
-   }
-} // schd_core_c::init(
+      // cres.exec_o -> disp_cres_exec -> chn_cres_exec[]
+      cres_info.second.mod_p.get().exec_o.bind( disp_cres_exec );
+
+      // disp_exec_cres -> chn_exec_cres -> cres.exec_i
+      cres_info.second.mod_p.get().exec_i.bind( cres_info.second.chn_exec_cres_p.get() );
+   } // BOOST_FOREACH( const cres_list_t::value_type& cres_info, cres_list )
+} // schd_core_c::init_direct(
 
 } // namespace schd
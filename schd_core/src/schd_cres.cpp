@@ -20,15 +20,20 @@ schd_cres_c::schd_cres_c(
       sc_core::sc_module_name nm )
    : sc_core::sc_module( nm )
    , exec_i( "exec_i" )
-   , exec_o( "exec_o" ) {
+   , exec_o( "exec_o" )
+   , dump_buf_exec_i( std::string( name()) + ".exec_i" )
+   , dump_buf_exec_o( std::string( name()) + ".exec_o" ) {
 
    // Process registrations
-   SC_THREAD( exec_thrd );
+   SC_METHOD( exec_meth );
+   sensitive << exec_i.data_written();
+   dont_initialize();
 }
 
 void schd_cres_c::init(
       boost::optional<const boost_pt::ptree&> _pref_p,
-      boost::optional<const boost_pt::ptree&> _exec_p ) {
+      boost::optional<const boost_pt::ptree&> _exec_p,
+      boost::optional<const boost_pt::ptree&> _core_p ) {
 
    try {
       capacity = _pref_p.get().get<double>("capacity");
@@ -61,6 +66,23 @@ void schd_cres_c::init(
 
       exec_list.emplace( std::make_pair( exec_name_p.get(), exec_data ));
    } // BOOST_FOREACH( const boost_pt::ptree::value_type& exec_el, _exec_p.get())
+
+   if( _core_p.is_initialized()) {
+      boost::optional<bool> coalesce_p = _core_p.get().get_optional<bool>("coalesce");
+
+      coalesce_en = coalesce_p.is_initialized() && coalesce_p.get();
+   }
+
+   // IDs which are used in the messages
+   cres_id = schd_msg_ids.cres_id( name());
+
+   exec_id_list.resize( schd_msg_ids.exec_size(), exec_list.end());
+
+   for( exec_list_t::iterator exec_it = exec_list.begin(); exec_it != exec_list.end(); exec_it ++ ) {
+      exec_it->second.id   = schd_msg_ids.exec_id( exec_it->first );
+      exec_it->second.rank = std::distance( exec_list.begin(), exec_it );
+      exec_id_list.at( exec_it->second.id ) = exec_it;
+   }
 } // void schd_cres_c::init(
 
 void schd_cres_c::add_trace(
@@ -94,116 +116,143 @@ void schd_cres_c::add_trace(
          mod_name + "capacity" );
 } // schd_cres_c::add_trace(
 
-void schd_cres_c::exec_thrd( void ) {
-   schd_dump_buf_c<boost_pt::ptree> dump_buf_exec_i( std::string( name()) + ".exec_i" );
-   schd_dump_buf_c<boost_pt::ptree> dump_buf_exec_o( std::string( name()) + ".exec_o" );
+void schd_cres_c::exec_meth( void ) {
+   sig_inp_list.clear();
+   exec_i->read_all( sig_inp_list );
 
-   sc_core::wait(sc_core::SC_ZERO_TIME);
+   BOOST_FOREACH( const schd_sig_ptree_c& sig_inp, sig_inp_list ) {
+      schd_msg_exec_cres_ptr exec_msg_p = sig_inp.msg_as<schd_msg_exec_cres_t>();
 
-   for(;;) {
-      sc_core::wait( exec_i->data_written_event());
+      if( !exec_msg_p ) {
+         SCHD_REPORT_ERROR( "schd::cres" ) << name() << " Incorrect data format from exec";
+      }
 
-      while( exec_i->num_available()) {
-         boost_pt::ptree        exec_pt_raw = exec_i->read().get();
-         const boost_pt::ptree& exec_pt_inp = exec_pt_raw;
+      const schd_msg_exec_cres_t& exec_msg = *exec_msg_p;
 
-         // Extract data from the received signal
-         boost::optional<std::string> exec_p = exec_pt_inp.get_optional<std::string>("src");    // exec name
-         boost::optional<bool>        conn_p = exec_pt_inp.get_optional<bool>("connected");     // connected state
-         boost::optional<double>      dmnd_p = exec_pt_inp.get_optional<double>("demand");      // demand
+      // Dump pt packets as they arrive to the input of the block
+      schd_msg_dump( dump_buf_exec_i, exec_msg );
 
-         if( !exec_p.is_initialized() ||
-             !conn_p.is_initialized() ||
-             !dmnd_p.is_initialized()) {
-            SCHD_REPORT_ERROR( "schd::cres" ) << name() << " Incorrect data format from exec";
-         }
+      // Update the record for the exec
+      if( exec_msg.src >= exec_id_list.size() || exec_id_list.at( exec_msg.src ) == exec_list.end()) {
+         SCHD_REPORT_ERROR( "schd::cres" )
+               << name()
+               << " Unexpected ID of the execution block: "
+               << exec_msg.src;
+      }
 
-         // Dump pt packets as they arrive to the input of the block
-         dump_buf_exec_i.write( exec_pt_inp, BUF_WRITE_LAST );
+      exec_list_t::iterator exec_it = exec_id_list.at( exec_msg.src );
 
-         // Update the record for the exec
-         auto exec_it = exec_list.find( exec_p.get());
+      if(( !exec_msg.connected && exec_msg.demand > 0 ) || ( exec_msg.demand < 0 )) {
+         SCHD_REPORT_ERROR( "schd::cres" )
+               << name()
+               << " Data integrity failed from: "
+               << exec_it->first;
+      }
 
-         if( exec_it == exec_list.end()) {
-            SCHD_REPORT_ERROR( "schd::cres" )
-                  << name()
-                  << " Unexpected name of the execution block: "
-                  << exec_p.get();
-         }
-         else if(( !conn_p.get() && dmnd_p.get() > 0 ) || ( dmnd_p.get() < 0 )) {
-            SCHD_REPORT_ERROR( "schd::cres" )
-                  << name()
-                  << " Data integrity failed from: "
-                  << exec_p.get();
-         }
+      bool conn_prev = exec_it->second.connected;
 
-         bool conn_prev = exec_it->second.connected;
-         exec_it->second.connected = conn_p.get();
-         exec_it->second.demand    = dmnd_p.get();
+      // Update the total demand incrementally
+      if( conn_prev ) {
+         demand_sum.sub( exec_it->second.demand );
+      }
 
-         boost_pt::ptree dst_list_pt;
-         double demand_acc = 0;
+      exec_it->second.connected = exec_msg.connected;
+      exec_it->second.demand    = exec_msg.demand;
 
-         BOOST_FOREACH( const exec_list_t::value_type& exec_el, exec_list ) {
-            if( exec_el.second.connected ) { // Accumulate demand
-               demand_acc += exec_el.second.demand;
-            }
-         }
+      if( exec_it->second.connected ) {
+         demand_sum.add( exec_it->second.demand );
+      }
 
-         // Broadcast updated demand to the exec blocks
-         if( demand != demand_acc ) {
-            demand = demand_acc;
+      if( conn_prev == false && exec_it->second.connected == true ) {
+         exec_con_list.push_back( exec_it ); // Just connected
+
+         exec_conn_list.insert(
+               std::lower_bound(
+                     exec_conn_list.begin(),
+                     exec_conn_list.end(),
+                     exec_it,
+                     []( const exec_list_t::iterator& lhs, const exec_list_t::iterator& rhs )->bool {
+                        return lhs->second.rank < rhs->second.rank; } ),
+               exec_it );
+      }
+      else if( conn_prev == true && exec_it->second.connected == false ) {
+         exec_dcn_list.push_back( exec_it ); // Just disconnected
+
+         exec_conn_list.erase(
+               std::find(
+                     exec_conn_list.begin(),
+                     exec_conn_list.end(),
+                     exec_it ));
+      }
 
-            BOOST_FOREACH( const exec_list_t::value_type& exec_el, exec_list ) {
-               if( exec_el.second.connected ) {
-                  dst_list_pt.push_back( std::make_pair( "", boost_pt::ptree().put( "", exec_el.first ) ));
-               }
-            }
-         }
-         else if( conn_prev == false && exec_it->second.connected == true ) {
-            dst_list_pt.push_back( std::make_pair( "", boost_pt::ptree().put( "", exec_it->first ) ));
-         }
+      if( !coalesce_en ) {
+         demand_send();
+      }
+   } // BOOST_FOREACH( const schd_sig_ptree_c& sig_inp, sig_inp_list )
 
-         if( !dst_list_pt.empty()) {
-            // Create property tree to broadcast data to all execution units
-            boost_pt::ptree cres_pt;
+   if( coalesce_en ) {
+      demand_send();
+   }
+} // schd_cres_c::exec_meth(
 
-            cres_pt.put(      "src",       name()      );   // Name of this resource
-            cres_pt.put_child("dst",       dst_list_pt );   // Update all exec units involved
-            cres_pt.put(      "demand",    demand      );   // Resource demand
-            cres_pt.put(      "connected", true        );   // Connected state
+void schd_cres_c::demand_send( void ) {
+   std::shared_ptr<schd_msg_cres_exec_t> cres_msg_p = std::make_shared<schd_msg_cres_exec_t>();
+   double demand_acc = demand_sum.value();
 
-            schd_sig_ptree_c pt_out;
+   // Broadcast updated demand to the exec blocks
+   if( demand != demand_acc ) {
+      demand = demand_acc;
 
-            exec_o->write( pt_out.set( cres_pt )); // Write data to the output
+      BOOST_FOREACH( exec_list_t::iterator exec_it, exec_conn_list ) {
+         cres_msg_p->dst.push_back( exec_it->second.id );
+      }
+   }
+   else {
+      // Acknowledge connection. Exec which has connected and disconnected since the last broadcast is skipped
+      BOOST_FOREACH( exec_list_t::iterator exec_it, exec_con_list ) {
+         if( exec_it->second.connected ) {
+            cres_msg_p->dst.push_back( exec_it->second.id );
+         }
+      }
+   }
+
+   if( !cres_msg_p->dst.empty()) {
+      // Message to broadcast data to all execution units
+      cres_msg_p->src       = cres_id;   // ID of this resource
+      cres_msg_p->demand    = demand;    // Resource demand
+      cres_msg_p->connected = true;      // Connected state
 
-            // Dump pt packets as they depart from the output of the block
-            dump_buf_exec_o.write( cres_pt, BUF_WRITE_LAST );
-         } // if( !dst_list_pt.empty()) {
+      schd_sig_ptree_c pt_out;
 
-         // Just disconnected
-         if( conn_prev == true && exec_it->second.connected == false ) {
-            dst_list_pt.clear();
+      exec_o->write( pt_out.set( cres_msg_p )); // Write data to the output
+
+      // Dump pt packets as they depart from the output of the block
+      schd_msg_dump( dump_buf_exec_o, *cres_msg_p );
+   } // if( !cres_msg_p->dst.empty()) {
+
+   // Just disconnected
+   BOOST_FOREACH( exec_list_t::iterator exec_it, exec_dcn_list ) {
+      if( exec_it->second.connected ) {
+         continue;
+      }
 
-            dst_list_pt.push_back( std::make_pair( "", boost_pt::ptree().put( "", exec_it->first ) ));
+      std::shared_ptr<schd_msg_cres_exec_t> dcn_msg_p = std::make_shared<schd_msg_cres_exec_t>();
 
-            // Create property tree to broadcast data to all execution units
-            boost_pt::ptree cres_pt;
+      dcn_msg_p->src       = cres_id;                 // ID of this resource
+      dcn_msg_p->dst.push_back( exec_it->second.id ); // Disconnected exec
+      dcn_msg_p->demand    = demand;                  // Resource demand
+      dcn_msg_p->connected = false;                   // Connected state
 
-            cres_pt.put(      "src",       name()      );   // Name of this resource
-            cres_pt.put_child("dst",       dst_list_pt );   // Update all exec units involved
-            cres_pt.put(      "demand",    demand      );   // Resource demand
-            cres_pt.put(      "connected", false       );   // Connected state
+      schd_sig_ptree_c pt_out;
 
-            schd_sig_ptree_c pt_out;
+      exec_o->write( pt_out.set( dcn_msg_p )); // Write data to the output
 
-            exec_o->write( pt_out.set( cres_pt )); // Write data to the output
+      // Dump pt packets as they depart from the output of the block
+      schd_msg_dump( dump_buf_exec_o, *dcn_msg_p );
+   } // BOOST_FOREACH( exec_list_t::iterator exec_it, exec_dcn_list )
 
-            // Dump pt packets as they depart from the output of the block
-            dump_buf_exec_o.write( cres_pt, BUF_WRITE_LAST );
-         } // if( conn_prev == true && ...
-      } // while( res_i->num_available()) {
-   } // for(;;)
-} // void schd_cres_c::exec_thrd(
+   exec_con_list.clear();
+   exec_dcn_list.clear();
+} // schd_cres_c::demand_send(
 
 } // namespace schd
@@ -0,0 +1,230 @@
+/*
+ * schd_cres_solver.cpp
+ *
+ *  Description:
+ *    Centralized solver for the common resource contention
+ */
+
+#include <algorithm>
+#include <iterator>
+#include <boost/foreach.hpp>
+#include "schd_cres_solver.h"
+#include "schd_sum.h"
+#include "schd_assert.h"
+#include "schd_report.h"
+
+namespace schd {
+
+void schd_cres_solver_c::init(
+      const std::vector<double>&      _cres_cap,
+      const std::vector<std::size_t>& _exec_rank,
+      const std::vector<std::size_t>& _cres_rank ) {
+
+   exec_rank = _exec_rank;
+   cres_rank = _cres_rank;
+
+   exec_list.resize( exec_rank.size());
+   cres_list.resize( cres_rank.size());
+
+   for( std::size_t cres_idx = 0; cres_idx < cres_list.size(); cres_idx ++ ) {
+      cres_list.at( cres_idx ).capacity = _cres_cap.at( cres_idx );
+   }
+
+   exec_dirty.resize( exec_list.size());
+   cres_dirty.resize( cres_list.size());
+} // schd_cres_solver_c::init(
+
+void schd_cres_solver_c::connect(
+      std::size_t exec_idx,
+      const std::vector<std::pair<std::size_t, double>>& plan_demand ) {
+   exec_data_t& exec_data = exec_list.at( exec_idx );
+
+   if( !exec_data.row.empty()) {
+      SCHD_REPORT_ERROR( "schd::solver" ) << "Duplicate connection for exec #" << exec_idx;
+   }
+
+   for( std::size_t dmnd_idx = 0; dmnd_idx < plan_demand.size(); dmnd_idx ++ ) {
+      link_t link_el;
+
+      link_el.cres_idx    = plan_demand.at( dmnd_idx ).first;
+      link_el.plan_demand = plan_demand.at( dmnd_idx ).second;
+      link_el.exec_demand = plan_demand.at( dmnd_idx ).second;
+
+      // Keep the row in the order of the cres names
+      row_t::iterator row_it = std::find_if(
+            exec_data.row.begin(),
+            exec_data.row.end(),
+            [this, &link_el]( const link_t& el )->bool {
+               return cres_rank.at( el.cres_idx ) >= cres_rank.at( link_el.cres_idx ); } );
+
+      if( row_it != exec_data.row.end() && row_it->cres_idx == link_el.cres_idx ) {
+         SCHD_REPORT_ERROR( "schd::solver" ) << "Duplicate connection for cres #" << link_el.cres_idx;
+      }
+
+      exec_data.row.insert( row_it, link_el );
+
+      // Keep the list of the connected execs in the order of the exec names
+      std::vector<std::size_t>& cres_exec_list = cres_list.at( link_el.cres_idx ).exec_list;
+
+      cres_exec_list.insert(
+            std::find_if(
+                  cres_exec_list.begin(),
+                  cres_exec_list.end(),
+                  [this, exec_idx]( std::size_t el )->bool {
+                     return exec_rank.at( el ) > exec_rank.at( exec_idx ); } ),
+            exec_idx );
+
+      cres_dirty[link_el.cres_idx] = true;
+   }
+
+   exec_data.time_ext_coe = 1.0;
+   exec_dirty[exec_idx]   = true;
+} // schd_cres_solver_c::connect(
+
+void schd_cres_solver_c::disconnect(
+      std::size_t exec_idx ) {
+   exec_data_t& exec_data = exec_list.at( exec_idx );
+
+   BOOST_FOREACH( const link_t& link_el, exec_data.row ) {
+      std::vector<std::size_t>& cres_exec_list = cres_list.at( link_el.cres_idx ).exec_list;
+
+      cres_exec_list.erase( std::remove(
+            cres_exec_list.begin(),
+            cres_exec_list.end(),
+            exec_idx ), cres_exec_list.end());
+
+      cres_dirty[link_el.cres_idx] = true;
+   }
+
+   exec_data.row.clear();
+   exec_data.time_ext_coe = 1.0;
+   exec_dirty[exec_idx]   = false;
+} // schd_cres_solver_c::disconnect(
+
+bool schd_cres_solver_c::solve(
+      std::vector<std::size_t>& exec_upd ) {
+   boost::dynamic_bitset<> exec_upd_bits( exec_list.size());  // Re-evaluated execs
+
+   exec_upd.clear();
+
+   if( cres_dirty.none() && exec_dirty.none()) {
+      return false;
+   }
+
+   // Same rounds as in the handshake: the resources update the total demand,
+   // then the execs update their loads and the reduced demands
+   while( cres_dirty.any() || exec_dirty.any()) {
+      boost::dynamic_bitset<> cres_run = cres_dirty;
+
+      cres_dirty.reset();
+
+      for( std::size_t cres_idx = cres_run.find_first();
+                       cres_idx < cres_run.size();
+                       cres_idx = cres_run.find_next( cres_idx )) {
+         cres_data_t& cres_data  = cres_list.at( cres_idx );
+         schd_sum_c   demand_sum;  // Same arithmetic as in schd_cres_c
+
+         BOOST_FOREACH( std::size_t exec_idx, cres_data.exec_list ) {
+            demand_sum.add( link( exec_idx, cres_idx ).exec_demand );
+         }
+
+         double demand_acc = demand_sum.value();
+
+         // Notify the connected execs on the change
+         if( cres_data.demand != demand_acc ) {
+            cres_data.demand = demand_acc;
+
+            BOOST_FOREACH( std::size_t exec_idx, cres_data.exec_list ) {
+               exec_dirty[exec_idx] = true;
+            }
+         }
+      } // for( std::size_t cres_idx = cres_run.find_first(); ...
+
+      boost::dynamic_bitset<> exec_run = exec_dirty;
+
+      exec_dirty.reset();
+
+      for( std::size_t exec_idx = exec_run.find_first();
+                       exec_idx < exec_run.size();
+                       exec_idx = exec_run.find_next( exec_idx )) {
+         exec_data_t& exec_data     = exec_list.at( exec_idx );
+         double       cres_load_max = 0;
+
+         exec_upd_bits[exec_idx] = true;
+
+         // Find common resource which is loaded at most
+         BOOST_FOREACH( link_t& link_el, exec_data.row ) {
+            link_el.cres_load = cres_list.at( link_el.cres_idx ).demand / cres_list.at( link_el.cres_idx ).capacity;
+            cres_load_max     = std::max( cres_load_max, link_el.cres_load );
+         }
+
+         // Update demand for the common resource if there are changes
+         BOOST_FOREACH( link_t& link_el, exec_data.row ) {
+            double exec_demand_new;
+
+            if(( cres_load_max <= 1.0 ) ||
+               ( cres_load_max == link_el.cres_load )) {
+               // Don't change the demand if the resource is not demanded above the capacity
+               // Don't change the demand for the resource with the max load
+               exec_demand_new = link_el.plan_demand;
+            }
+            else {
+               // Reduce the demand for the resources other than one with max load.
+               // This models the demand while execution block is stalled by the shortage of supply
+               exec_demand_new = link_el.plan_demand / cres_load_max;
+            }
+
+            if( link_el.exec_demand != exec_demand_new ) {
+               link_el.exec_demand = exec_demand_new;
+               cres_dirty[link_el.cres_idx] = true;
+            }
+         } // BOOST_FOREACH( link_t& link_el, exec_data.row )
+
+         // Update time extension coefficient
+         exec_data.time_ext_coe = std::max( cres_load_max, 1.0 );
+      } // for( std::size_t exec_idx = exec_run.find_first(); ...
+   } // while( cres_dirty.any() || exec_dirty.any())
+
+   for( std::size_t exec_idx = exec_upd_bits.find_first();
+                    exec_idx < exec_upd_bits.size();
+                    exec_idx = exec_upd_bits.find_next( exec_idx )) {
+      exec_upd.push_back( exec_idx );
+   }
+
+   return true;
+} // schd_cres_solver_c::solve(
+
+double schd_cres_solver_c::time_ext_coe(
+      std::size_t exec_idx ) const {
+   return exec_list.at( exec_idx ).time_ext_coe;
+} // schd_cres_solver_c::time_ext_coe(
+
+const schd_cres_solver_c::row_t& schd_cres_solver_c::row(
+      std::size_t exec_idx ) const {
+   return exec_list.at( exec_idx ).row;
+} // schd_cres_solver_c::row(
+
+double schd_cres_solver_c::demand(
+      std::size_t cres_idx ) const {
+   return cres_list.at( cres_idx ).demand;
+} // schd_cres_solver_c::demand(
+
+schd_cres_solver_c::link_t& schd_cres_solver_c::link(
+      std::size_t exec_idx,
+      std::size_t cres_idx ) {
+   row_t& row = exec_list.at( exec_idx ).row;
+
+   row_t::iterator row_it = std::find_if(
+         row.begin(),
+         row.end(),
+         [cres_idx]( const link_t& el )->bool {
+            return el.cres_idx == cres_idx; } );
+
+   if( row_it == row.end()) {
+      SCHD_REPORT_ERROR( "schd::solver" ) << "Link is not found for exec #" << exec_idx << " cres #" << cres_idx;
+   }
+
+   return *row_it;
+} // schd_cres_solver_c::link(
+
+} // namespace schd
@@ -9,7 +9,6 @@
 #include <iterator>
 #include <boost/foreach.hpp>
 #include "schd_exec.h"
-#include "schd_ptree_time.h"
 #include "schd_conv_ptree.h"
 #include "schd_dump.h"
 #include "schd_trace.h"
@@ -26,40 +25,45 @@ schd_exec_c::schd_exec_c(
    , plan_o( "plan_o" )
    , cres_i( "cres_i" )
    , cres_o( "cres_o" )
+   , dump_buf_plan_i( std::string( name()) + ".plan_i" )
+   , dump_buf_plan_o( std::string( name()) + ".plan_o" )
+   , dump_buf_cres_i( std::string( name()) + ".cres_i" )
+   , dump_buf_cres_o( std::string( name()) + ".cres_o" )
    , exec_complete( "exec_complete" ) {
 
    // Process registrations
-   SC_THREAD( exec_thrd );
+   SC_METHOD( exec_meth );
+   sensitive << plan_i.data_written()
+             << cres_i.data_written()
+             << exec_complete;
+   dont_initialize();
 }
 
 void schd_exec_c::init(
       boost::optional<const boost_pt::ptree&> _exec_p,
-      boost::optional<const boost_pt::ptree&> _cres_p ) {
+      std::shared_ptr<const cres_cap_list_t>  _cres_cap_p,
+      std::shared_ptr<const cres_rank_list_t> _cres_rank_p,
+      boost::optional<const boost_pt::ptree&> _core_p ) {
 
-   // Create cres instances and the corresponding channels
-   BOOST_FOREACH( const boost_pt::ptree::value_type& cres_el, _cres_p.get()) {
-      if( !cres_el.first.empty()) {
-         SCHD_REPORT_ERROR( "schd::exec" ) << name() <<  " Incorrect cres structure";
-      }
+   if( !_cres_cap_p || !_cres_rank_p || _cres_rank_p->size() != _cres_cap_p->size()) {
+      SCHD_REPORT_ERROR( "schd::exec" ) << name() <<  " Incorrect cres structure";
+   }
 
-      boost::optional<std::string> cres_name_p = cres_el.second.get_optional<std::string>("name");
-      boost::optional<double>      cres_cap_p  = cres_el.second.get_optional<double>("capacity");
+   cres_cap_p  = _cres_cap_p;
+   cres_rank_p = _cres_rank_p;
 
-      if( !cres_name_p.is_initialized() ||
-          !cres_cap_p.is_initialized()) {
-         SCHD_REPORT_ERROR( "schd::exec" ) << name() <<  " Incorrect cres structure";
-      }
+   if( _core_p.is_initialized()) {
+      boost::optional<bool> coalesce_p = _core_p.get().get_optional<bool>("coalesce");
 
-      // Initialise cres data
-      schd_exec_c::cres_data_t cres_data;
-      cres_data.capacity     = cres_cap_p.get();
+      coalesce_en = coalesce_p.is_initialized() && coalesce_p.get();
 
-      if( cres_data.capacity <= 0.0 ) {
-         SCHD_REPORT_ERROR( "schd::exec" ) << name() << " Incorrect capacity specification";
-      }
+      boost::optional<bool> time_exact_p = _core_p.get().get_optional<bool>("time_exact");
 
-      cres_list.emplace( std::make_pair( cres_name_p.get(), cres_data ));
-   } // BOOST_FOREACH( const boost_pt::ptree::value_type& cres_el, _cres_p.get())
+      time_exact_en = time_exact_p.is_initialized() && time_exact_p.get();
+   }
+
+   // IDs which are used in the messages
+   exec_id = schd_msg_ids.exec_id( name());
 
 } // schd_exec_c::init(
 
@@ -69,37 +73,47 @@ void schd_exec_c::add_trace(
 
    std::string mod_name = top_name + "." + name() + ".";
 
-   // Add trace for cres
-   BOOST_FOREACH( cres_list_t::value_type& cres_el, cres_list ) {
-      sc_core::sc_trace(
-            tf,
-            &( cres_el.second.capacity ),
-            mod_name + cres_el.first + ".capacity" );
-
-      sc_core::sc_trace(
-            tf,
-            &( cres_el.second.connected ),
-            mod_name + cres_el.first + ".connected" );
-
-      sc_core::sc_trace(
-            tf,
-            &( cres_el.second.cres_demand ),
-            mod_name + cres_el.first + ".cres_demand" );
-
-      sc_core::sc_trace(
-            tf,
-            &( cres_el.second.cres_load ),
-            mod_name + cres_el.first + ".cres_load" );
-
-      sc_core::sc_trace(
-            tf,
-            &( cres_el.second.plan_demand ),
-            mod_name + cres_el.first + ".plan_demand" );
-
-      sc_core::sc_trace(
-            tf,
-            &( cres_el.second.exec_demand ),
-            mod_name + cres_el.first + ".exec_demand" );
+   // Add trace for cres. Traced values are copied from the list of the current task
+   if( tf ) {
+      cres_trace_list.resize( cres_cap_p->size());
+
+      for( std::size_t cres_idx = 0; cres_idx < cres_trace_list.size(); cres_idx ++ ) {
+         cres_data_t&       cres_el   = cres_trace_list.at( cres_idx );
+         const std::string& cres_name = schd_msg_ids.cres_name( cres_idx );
+
+         cres_el.id       = cres_idx;
+         cres_el.capacity = cres_cap_p->at( cres_idx );
+
+         sc_core::sc_trace(
+               tf,
+               &( cres_el.capacity ),
+               mod_name + cres_name + ".capacity" );
+
+         sc_core::sc_trace(
+               tf,
+               &( cres_el.connected ),
+               mod_name + cres_name + ".connected" );
+
+         sc_core::sc_trace(
+               tf,
+               &( cres_el.cres_demand ),
+               mod_name + cres_name + ".cres_demand" );
+
+         sc_core::sc_trace(
+               tf,
+               &( cres_el.cres_load ),
+               mod_name + cres_name + ".cres_load" );
+
+         sc_core::sc_trace(
+               tf,
+               &( cres_el.plan_demand ),
+               mod_name + cres_name + ".plan_demand" );
+
+         sc_core::sc_trace(
+               tf,
+               &( cres_el.exec_demand ),
+               mod_name + cres_name + ".exec_demand" );
+      }
    }
 
    // Add trace for job hash
@@ -110,350 +124,385 @@ void schd_exec_c::add_trace(
 
 } // schd_exec_c::add_trace(
 
-void schd_exec_c::exec_thrd( void ) {
-   schd_dump_buf_c<boost_pt::ptree> dump_buf_plan_i( std::string( name()) + ".plan_i" );
-   schd_dump_buf_c<boost_pt::ptree> dump_buf_plan_o( std::string( name()) + ".plan_o" );
-   schd_dump_buf_c<boost_pt::ptree> dump_buf_cres_i( std::string( name()) + ".cres_i" );
-   schd_dump_buf_c<boost_pt::ptree> dump_buf_cres_o( std::string( name()) + ".cres_o" );
-
-   sc_core::wait(sc_core::SC_ZERO_TIME);
+void schd_exec_c::exec_meth( void ) {
+   // Same wakeup condition as the wait for the event list in the process loop:
+   // completion is observed only while the execution is in progress
+   if( !plan_i->data_written_event().triggered() &&
+       !cres_i->data_written_event().triggered() &&
+       !( complete_en && exec_complete.triggered())) {
+      return;
+   }
 
-   for(;;) {
-      sc_core::sc_event_or_list ports_run_or_list;
+   // Check if there is new data from the planner
+   sig_inp_list.clear();
+   plan_i->read_all( sig_inp_list );
 
-      ports_run_or_list |= plan_i->data_written_event();
-      ports_run_or_list |= cres_i->data_written_event();
+   BOOST_FOREACH( const schd_sig_ptree_c& sig_inp, sig_inp_list ) {
+      schd_msg_plan_exec_ptr plan_msg_p = sig_inp.msg_as<schd_msg_plan_exec_t>();
 
-      if( time_to_go != sc_core::SC_ZERO_TIME ) {
-         ports_run_or_list |= exec_complete;
+      if( !plan_msg_p ) {
+         SCHD_REPORT_ERROR( "schd::exec" ) << name() << " Incorrect data format from planner";
       }
 
-      sc_core::wait( ports_run_or_list ); // Wait for any event from the list to trigger
-
-      // Check if there is new data from the planner
-      while( plan_i->num_available()) {
-         boost_pt::ptree        plan_pt_raw = plan_i->read().get();
-         const boost_pt::ptree& plan_pt_inp = plan_pt_raw;
-
-         // Extract data from the received signal
-         boost::optional<std::string>            thrd_p = plan_pt_inp.get_optional<std::string>("thread");        // Tread name
-         boost::optional<std::string>            task_p = plan_pt_inp.get_optional<std::string>("task");          // task name
-         boost::optional<const boost_pt::ptree&> para_p = plan_pt_inp.get_child_optional("param");                // parameters ptree
-
-         boost::optional<sc_core::sc_time>       time_p = plan_pt_inp.get_optional<sc_core::sc_time>("runtime");  // execution time
-         boost::optional<const boost_pt::ptree&> cres_p = plan_pt_inp.get_child_optional("common");               // Common resources
+      const schd_msg_plan_exec_t& plan_msg = *plan_msg_p;
 
-         if( !thrd_p.is_initialized() ||
-             !task_p.is_initialized() ||
-             !para_p.is_initialized() ||
-             !time_p.is_initialized() ||
-             !cres_p.is_initialized()) {
-            std::string plan_pt_str;
+      // Extract data from the received message
+      if( !plan_msg.param.is_initialized()) {
+         SCHD_REPORT_ERROR( "schd::exec" ) << name() << " Incorrect data format from planner";
+      }
 
-            SCHD_REPORT_ERROR( "schd::exec" ) << name()
-                                              << " Incorrect data format from planner: "
-                                              << pt2str( plan_pt_inp, plan_pt_str );
-         }
+      boost::optional<std::string> prid_p = plan_msg.param.get().get_optional<std::string>("id");
 
-         boost::optional<std::string> prid_p = para_p.get().get_optional<std::string>("id");
+      if( !prid_p.is_initialized() ) {
+         std::string plan_pt_str;
+         boost_pt::ptree plan_pt;
 
-         if( !prid_p.is_initialized() ) {
-            std::string plan_pt_str;
+         plan_msg.to_ptree( plan_pt );
 
-            SCHD_REPORT_ERROR( "schd::exec" ) << name()
-                                              << " Incorrect data format from planner: "
-                                              << pt2str( plan_pt_inp, plan_pt_str );
-         }
+         SCHD_REPORT_ERROR( "schd::exec" ) << name()
+                                           << " Incorrect data format from planner: "
+                                           << pt2str( plan_pt, plan_pt_str );
+      }
 
-         // Dump pt packets as they arrive to the input of the block
-         dump_buf_plan_i.write( plan_pt_inp, BUF_WRITE_LAST );
+      // Dump pt packets as they arrive to the input of the block
+      schd_msg_dump( dump_buf_plan_i, plan_msg );
 
-         // Save task name
-         if( job_hash == 0 ) {
-            thrd_name = thrd_p.get();
-            task_name = task_p.get();
-             param_id = prid_p.get();
-         }
-         else {
-            SCHD_REPORT_ERROR( "simd::exec" ) << " Unexpected request from the planner: "
-                                              << schd_trace.job_comb(
-                                                    thrd_p.get(),
-                                                    task_p.get(),
-                                                    prid_p.get())
-                                              << " while running: "
-                                              << schd_trace.job_comb(
-                                                    thrd_name,
-                                                    task_name,
-                                                    param_id );
-         }
-
-         // Update the list of the common resources and notify common resources
-         BOOST_FOREACH( const boost_pt::ptree::value_type& cres_el, cres_p.get()) {
-            if( !cres_el.first.empty()) {
-               SCHD_REPORT_ERROR( "schd::exec" ) << name() <<  " Incorrect structure";
-            }
-
-            boost::optional<std::string> name_p = cres_el.second.get_optional<std::string>("res");
-            boost::optional<double>      dmnd_p = cres_el.second.get_optional<double>("demand");
-
-            // Check availability of the fields
-            if( !name_p.is_initialized() ||
-                !dmnd_p.is_initialized() ||
-                 dmnd_p.get() < 0 ) {
-               SCHD_REPORT_ERROR( "schd::exec" ) << name() << " Incorrect data format from planner";
-            } // if( !name_p.is_initialized() || ...
-
-            auto cres_list_it = cres_list.find( name_p.get());
-
-            if( cres_list_it == cres_list.end()) {
-               SCHD_REPORT_ERROR( "schd::exec" )
-                     << name()
-                     << " Unexpected resorce name: "
-                     << name_p.get();
-            }
-            else if( cres_list_it->second.state != CRES_STATE_IDLE ) {
-               SCHD_REPORT_ERROR( "schd::exec" )
-                     << name()
-                     << " Duplicate connection for: "
-                     << name_p.get();
-            }
-
-            // Initialise cres data
-            cres_list_it->second.state       = CRES_STATE_WAIT_CON;
-            cres_list_it->second.cres_demand = 0.0;
-            cres_list_it->second.cres_load   = 0.0;
-            cres_list_it->second.plan_demand = dmnd_p.get();
-            cres_list_it->second.exec_demand = dmnd_p.get();
-
-            // Notify common resource on the new demand
-            boost_pt::ptree  dst_list_pt;
-            boost_pt::ptree  exec_pt;
-            schd_sig_ptree_c pt_out;
-
-            dst_list_pt.push_back( std::make_pair( "", boost_pt::ptree().put( "", name_p.get() ) ));
-
-            // Notify common resources from the list on the new demand
-            exec_pt.put(      "src",       name()       ); // Name of this resource
-            exec_pt.put_child("dst",       dst_list_pt  ); // Common resource to update
-            exec_pt.put(      "connected", true         ); // Connected
-            exec_pt.put(      "demand",    dmnd_p.get() ); // Resource demand from this execution block
-
-            cres_o->write( pt_out.set( exec_pt )); // Write data to the output
+      // Save task name
+      if( job_hash == 0 ) {
+         thrd_id   = plan_msg.thrd_id;
+         task_id   = plan_msg.task_id;
+          param_id = prid_p.get();
+      }
+      else {
+         SCHD_REPORT_ERROR( "simd::exec" ) << " Unexpected request from the planner: "
+                                           << schd_trace.job_comb(
+                                                 schd_msg_ids.thrd_name( plan_msg.thrd_id ),
+                                                 schd_msg_ids.task_name( plan_msg.task_id ),
+                                                 prid_p.get())
+                                           << " while running: "
+                                           << schd_trace.job_comb(
+                                                 schd_msg_ids.thrd_name( thrd_id ),
+                                                 schd_msg_ids.task_name( task_id ),
+                                                 param_id );
+      }
 
-            // Dump pt packets as they depart from the output of the block
-            dump_buf_cres_o.write( exec_pt, BUF_WRITE_LAST );
-         } // BOOST_FOREACH( const boost_pt::ptree::value_type& cres_el, cres_p.get())
-
-         // Update time and run the execution
-         time_to_go = time_p.get();
-         time_upd   = sc_core::sc_time_stamp();
-         time_ext_coe = 1.0;
-
-         std::string job_tag = schd_trace.job_comb(
-               thrd_p.get(),
-               task_p.get(),
-               prid_p.get());
-
-         job_hash = 0;
-         boost::hash_combine(
-               job_hash,
-               job_tag  );
-
-         exec_complete.notify( time_to_go );
-
-      } // while( plan_i->num_available())
-
-      // Check if there is new data from common resources
-      while( cres_i->num_available()) {
-         boost_pt::ptree        cres_pt_raw = cres_i->read().get();
-         const boost_pt::ptree& cres_pt_inp = cres_pt_raw;
-
-         // Extract data from the received signal
-         boost::optional<std::string> cres_p = cres_pt_inp.get_optional<std::string>("src");    // cres name
-         boost::optional<double>      dmnd_p = cres_pt_inp.get_optional<double>("demand");      // demand
-         boost::optional<bool>        stat_p = cres_pt_inp.get_optional<bool>("connected");      // connection state
-
-         if( !cres_p.is_initialized() ||
-             !dmnd_p.is_initialized() ||
-             !stat_p.is_initialized()) {
-            std::string cres_pt_str;
-
-            SCHD_REPORT_ERROR( "schd::exec" ) << name()
-                                              << " Incorrect data format from cres: "
-                                              << pt2str( cres_pt_inp, cres_pt_str );
+      // Update the list of the common resources and notify common resources
+      BOOST_FOREACH( const schd_msg_plan_exec_t::cres_t& cres_el, plan_msg.cres_list ) {
+         // Check the fields
+         if( cres_el.demand < 0 ) {
+            SCHD_REPORT_ERROR( "schd::exec" ) << name() << " Incorrect data format from planner";
          }
 
-         // Dump pt packets as they arrive to the input of the block
-         dump_buf_cres_i.write( cres_pt_inp, BUF_WRITE_LAST );
-
-         auto cres_list_it = cres_list.find( cres_p.get());
-
-         if( cres_list_it == cres_list.end()) {
+         if( cres_el.id >= cres_cap_p->size()) {
             SCHD_REPORT_ERROR( "schd::exec" )
                   << name()
-                  << " Unexpected resource name: "
-                  << cres_p.get();
+                  << " Unexpected resorce ID: "
+                  << cres_el.id;
          }
-         else if( cres_list_it->second.state == CRES_STATE_IDLE ) {
+
+         if( cres_find( cres_el.id ) != cres_list.end()) {
             SCHD_REPORT_ERROR( "schd::exec" )
                   << name()
-                  << " Unexpected update from: "
-                  << cres_p.get();
+                  << " Duplicate connection for: "
+                  << schd_msg_ids.cres_name( cres_el.id );
          }
 
+         // Initialise cres data
+         cres_data_t cres_data;
+
+         cres_data.id          = cres_el.id;
+         cres_data.capacity    = cres_cap_p->at( cres_el.id );
+         cres_data.state       = CRES_STATE_WAIT_CON;
+         cres_data.plan_demand = cres_el.demand;
+         cres_data.exec_demand = cres_el.demand;
+
+         // Keep the order of the names, so the messages to the resources are sent in the same order
+         // as by the native engine
+         std::size_t cres_rank = cres_rank_p->at( cres_el.id );
+
+         cres_list.insert(
+               std::find_if(
+                     cres_list.begin(),
+                     cres_list.end(),
+                     [this, cres_rank]( const cres_data_t& el )->bool {
+                        return cres_rank_p->at( el.id ) > cres_rank; } ),
+               cres_data );
+
          // Notify common resource on the new demand
-         boost_pt::ptree  dst_list_pt;
-         boost_pt::ptree  exec_pt;
-         schd_sig_ptree_c pt_out;
-
-         if( stat_p.get() && cres_list_it->second.state != CRES_STATE_IDLE &&
-                             cres_list_it->second.state != CRES_STATE_WAIT_DCN ) {
-            cres_list_it->second.state       = CRES_STATE_CONNECTED;
-            cres_list_it->second.connected   = true;
-            cres_list_it->second.cres_demand = dmnd_p.get();
-            cres_list_it->second.cres_load   = dmnd_p.get() / cres_list_it->second.capacity;
-
-            double cres_load_max = 0;
-
-            // Find common resource which is loaded at most
-            BOOST_FOREACH( const cres_list_t::value_type& cres_el, cres_list ) {
-               if( cres_el.second.state == CRES_STATE_CONNECTED ) {
-                  cres_load_max = std::max( cres_load_max, cres_el.second.cres_load );
-               }
-            }
-
-            // Update demand for the common resource if there are changes
-            BOOST_FOREACH( cres_list_t::value_type& cres_el, cres_list ) {
-               if( cres_el.second.state != CRES_STATE_CONNECTED ) {
-                  continue;
-               }
-
-               double exec_demand_new;
-
-               if(( cres_load_max <= 1.0 ) ||
-                  ( cres_load_max == cres_el.second.cres_load )) {
-                  // Don't change the demand if the resource is not demanded above the capacity
-                  // Don't change the demand for the resource with the max load
-                  exec_demand_new = cres_el.second.plan_demand;
-               }
-               else {
-                  // Reduce the demand for the resources other than one with max load.
-                  // This models the demand while execution block is stalled by the shortage of supply
-                  exec_demand_new = cres_el.second.plan_demand / cres_load_max;
-               }
-
-               // Check if the reported demand has changed
-               if( cres_el.second.exec_demand != exec_demand_new ) {
-                  cres_el.second.exec_demand = exec_demand_new;
-
-                  // Notify common resource from the list on the new demand
-                  dst_list_pt.clear();
-
-                  dst_list_pt.push_back( std::make_pair( "", boost_pt::ptree().put( "", cres_el.first ) ));
-
-                  exec_pt.put(      "src",       name()          ); // Name of this resource
-                  exec_pt.put_child("dst",       dst_list_pt     ); // Common resource to update
-                  exec_pt.put(      "connected", true            ); // Connected
-                  exec_pt.put(      "demand",    exec_demand_new ); // Demand
-
-                  cres_o->write( pt_out.set( exec_pt )); // Write data to the output
-
-                  // Dump pt packets as they depart from the output of the block
-                  dump_buf_cres_o.write( exec_pt, BUF_WRITE_LAST );
-               } // if( cres_el.second.exec_demand != exec_demand_new )  ...
-            } // BOOST_FOREACH( const cres_list_t::value_type& cres_el, cres_list )
-
-            // Update time to go
-            double time_ext_coe_new = std::max( cres_load_max, 1.0 );
-
-            if( time_ext_coe != time_ext_coe_new ) {
-               time_to_go = ( time_to_go - ( sc_core::sc_time_stamp() - time_upd )) / time_ext_coe * time_ext_coe_new;
-               time_upd   = sc_core::sc_time_stamp();
-
-               time_ext_coe = time_ext_coe_new;
-
-               exec_complete.cancel();
-               exec_complete.notify( time_to_go );
-            } // if( time_ext_coe != time_ext_coe_new )
-         } // if( stat_p.get() )
-         else if ( !stat_p.get() && cres_list_it->second.state == CRES_STATE_WAIT_DCN ) {
-            cres_list_it->second.state     = CRES_STATE_IDLE;
-            cres_list_it->second.connected = false;
-
-            if( cres_list.end() == std::find_if(
-                  cres_list.begin(),
-                  cres_list.end(),
-                  []( const cres_list_t::value_type& el )->bool {
-                     return el.second.state != CRES_STATE_IDLE; } )) {
-               // Notify planner that the execution is complete
-               dst_list_pt.push_back( std::make_pair( "", boost_pt::ptree().put( "", "planner" ) ));
-
-               exec_pt.put(       "src",  name()      );  // Name of this executor
-               exec_pt.put_child( "dst",  dst_list_pt );  // Destination: planner
-
-               plan_o->write( pt_out.set( exec_pt )); // Write data to the output
-
-               // Dump pt packets as they depart from the output of the block
-               dump_buf_plan_o.write( exec_pt, BUF_WRITE_LAST );
-            }
-         } // if( stat_p.get() ) ... else ...
-         else if( stat_p.get() && cres_list_it->second.state == CRES_STATE_WAIT_DCN ) {
-            ;
-         }
-         else {
-            SCHD_REPORT_ERROR( "schd::exec" ) << name() << " Unexpected state transition";
-         }
-      } // while( cres_i->num_available())
-
-      // Check if the execution is complete
-      if( exec_complete.triggered()) {
-         time_to_go   = sc_core::SC_ZERO_TIME;
-         time_ext_coe = 1.0;
-
-         boost_pt::ptree  dst_list_pt;
-         boost_pt::ptree  exec_pt;
-         schd_sig_ptree_c pt_out;
-
-         BOOST_FOREACH( cres_list_t::value_type& cres_el, cres_list ) {
-            if( cres_el.second.state != CRES_STATE_IDLE ) {
-               dst_list_pt.push_back( std::make_pair( "", boost_pt::ptree().put( "", cres_el.first ) ));
-
-               cres_el.second.state       = CRES_STATE_WAIT_DCN;
-               cres_el.second.cres_demand = 0.0;
-               cres_el.second.cres_load   = 0.0;
-               cres_el.second.plan_demand = 0.0;
-               cres_el.second.exec_demand = 0.0;
-            }
-         }
+         std::shared_ptr<schd_msg_exec_cres_t> exec_msg_p = std::make_shared<schd_msg_exec_cres_t>();
+         schd_sig_ptree_c                      pt_out;
 
-         // Notify common resources from the list that the executor now has zero demand
-         if( !dst_list_pt.empty()) {
-            exec_pt.put(      "src",       name()      ); // Name of this resource
-            exec_pt.put_child("dst",       dst_list_pt ); // Update all common resources involved
-            exec_pt.put(      "connected", false       ); // No longer connected
-            exec_pt.put(      "demand",    0.0         ); // Zero demand
+         exec_msg_p->src       = exec_id;          // ID of this exec
+         exec_msg_p->dst.push_back( cres_el.id );  // Common resource to update
+         exec_msg_p->connected = true;             // Connected
+         exec_msg_p->demand    = cres_el.demand;   // Resource demand from this execution block
 
-            cres_o->write( pt_out.set( exec_pt )); // Write data to the output
+         cres_o->write( pt_out.set( exec_msg_p )); // Write data to the output
 
-            // Dump pt packets as they depart from the output of the block
-            dump_buf_cres_o.write( exec_pt, BUF_WRITE_LAST );
+         // Dump pt packets as they depart from the output of the block
+         schd_msg_dump( dump_buf_cres_o, *exec_msg_p );
+      } // BOOST_FOREACH( const schd_msg_plan_exec_t::cres_t& cres_el, plan_msg.cres_list )
+
+      // Update time and run the execution
+      time_to_go = plan_msg.runtime;
+      time_upd   = sc_core::sc_time_stamp();
+      time_ext_coe = 1.0;
+
+      if( time_exact_en ) {
+         work.start( time_to_go );
+      }
+
+      std::string job_tag = schd_trace.job_comb(
+            schd_msg_ids.thrd_name( plan_msg.thrd_id ),
+            schd_msg_ids.task_name( plan_msg.task_id ),
+            prid_p.get());
+
+      job_hash = 0;
+      boost::hash_combine(
+            job_hash,
+            job_tag  );
+
+      exec_complete.notify( time_to_go );
+
+   } // BOOST_FOREACH( const schd_sig_ptree_c& sig_inp, sig_inp_list )
+
+   // Check if there is new data from common resources
+   sig_inp_list.clear();
+   cres_i->read_all( sig_inp_list );
+
+   bool demand_upd = false;   // Loads have changed. Used if the updates are coalesced
+
+   BOOST_FOREACH( const schd_sig_ptree_c& sig_inp, sig_inp_list ) {
+      schd_msg_cres_exec_ptr cres_msg_p = sig_inp.msg_as<schd_msg_cres_exec_t>();
+
+      if( !cres_msg_p ) {
+         SCHD_REPORT_ERROR( "schd::exec" ) << name() << " Incorrect data format from cres";
+      }
+
+      const schd_msg_cres_exec_t& cres_msg = *cres_msg_p;
+
+      // Dump pt packets as they arrive to the input of the block
+      schd_msg_dump( dump_buf_cres_i, cres_msg );
+
+      if( cres_msg.src >= cres_cap_p->size()) {
+         SCHD_REPORT_ERROR( "schd::exec" )
+               << name()
+               << " Unexpected resource ID: "
+               << cres_msg.src;
+      }
+
+      cres_list_t::iterator cres_list_it = cres_find( cres_msg.src );
+
+      if( cres_list_it == cres_list.end()) {
+         SCHD_REPORT_ERROR( "schd::exec" )
+               << name()
+               << " Unexpected update from: "
+               << schd_msg_ids.cres_name( cres_msg.src );
+      }
+
+      schd_sig_ptree_c pt_out;
+
+      if( cres_msg.connected && cres_list_it->state != CRES_STATE_IDLE &&
+                                cres_list_it->state != CRES_STATE_WAIT_DCN ) {
+         cres_list_it->state       = CRES_STATE_CONNECTED;
+         cres_list_it->connected   = true;
+         cres_list_it->cres_demand = cres_msg.demand;
+
+         cres_load_set( *cres_list_it, cres_msg.demand / cres_list_it->capacity );
+
+         if( coalesce_en ) {
+            demand_upd = true;
          }
          else {
+            demand_update();
+         }
+      } // if( cres_msg.connected )
+      else if ( !cres_msg.connected && cres_list_it->state == CRES_STATE_WAIT_DCN ) {
+         cres_list_it->state     = CRES_STATE_IDLE;
+         cres_list_it->connected = false;
+
+         // Idle resources are no longer part of the task
+         trace_update( *cres_list_it );
+         cres_list.erase( cres_list_it );
+
+         if( cres_list.empty()) {
             // Notify planner that the execution is complete
-            dst_list_pt.push_back( std::make_pair( "", boost_pt::ptree().put( "", "planner" ) ));
+            std::shared_ptr<schd_msg_exec_plan_t> exec_msg_p = std::make_shared<schd_msg_exec_plan_t>();
 
-            exec_pt.put(       "src",  name()      );  // Name of this executor
-            exec_pt.put_child( "dst",  dst_list_pt );  // Destination: planner
+            exec_msg_p->src = exec_id;  // ID of this executor
 
-            plan_o->write( pt_out.set( exec_pt )); // Write data to the output
+            plan_o->write( pt_out.set( exec_msg_p )); // Write data to the output
 
             // Dump pt packets as they depart from the output of the block
-            dump_buf_plan_o.write( exec_pt, BUF_WRITE_LAST );
+            schd_msg_dump( dump_buf_plan_o, *exec_msg_p );
          }
+      } // if( cres_msg.connected ) ... else ...
+      else if( cres_msg.connected && cres_list_it->state == CRES_STATE_WAIT_DCN ) {
+         ;
+      }
+      else {
+         SCHD_REPORT_ERROR( "schd::exec" ) << name() << " Unexpected state transition";
+      }
+   } // BOOST_FOREACH( const schd_sig_ptree_c& sig_inp, sig_inp_list )
 
-         job_hash = 0;
-      } // if( exec_complete.triggered())
-   } // for(;;)
-}
+   if( demand_upd ) {
+      demand_update();
+   }
+
+   // Check if the execution is complete
+   if( exec_complete.triggered()) {
+      time_to_go   = sc_core::SC_ZERO_TIME;
+      time_ext_coe = 1.0;
+
+      std::shared_ptr<schd_msg_exec_cres_t> exec_msg_p = std::make_shared<schd_msg_exec_cres_t>();
+      schd_sig_ptree_c                      pt_out;
+
+      BOOST_FOREACH( cres_data_t& cres_el, cres_list ) {
+         exec_msg_p->dst.push_back( cres_el.id );
+
+         cres_el.state       = CRES_STATE_WAIT_DCN;
+         cres_el.cres_demand = 0.0;
+         cres_el.cres_load   = 0.0;
+         cres_el.plan_demand = 0.0;
+         cres_el.exec_demand = 0.0;
+      }
+
+      cres_load_max = 0.0;
+
+      // Notify common resources from the list that the executor now has zero demand
+      if( !exec_msg_p->dst.empty()) {
+         exec_msg_p->src       = exec_id;   // ID of this exec
+         exec_msg_p->connected = false;     // No longer connected
+         exec_msg_p->demand    = 0.0;       // Zero demand
+
+         cres_o->write( pt_out.set( exec_msg_p )); // Write data to the output
+
+         // Dump pt packets as they depart from the output of the block
+         schd_msg_dump( dump_buf_cres_o, *exec_msg_p );
+      }
+      else {
+         // Notify planner that the execution is complete
+         std::shared_ptr<schd_msg_exec_plan_t> plan_msg_p = std::make_shared<schd_msg_exec_plan_t>();
+
+         plan_msg_p->src = exec_id;  // ID of this executor
+
+         plan_o->write( pt_out.set( plan_msg_p )); // Write data to the output
+
+         // Dump pt packets as they depart from the output of the block
+         schd_msg_dump( dump_buf_plan_o, *plan_msg_p );
+      }
+
+      job_hash = 0;
+   } // if( exec_complete.triggered())
+
+   if( !cres_trace_list.empty()) {
+      BOOST_FOREACH( const cres_data_t& cres_el, cres_list ) {
+         trace_update( cres_el );
+      }
+   }
+
+   complete_en = ( time_to_go != sc_core::SC_ZERO_TIME );
+} // schd_exec_c::exec_meth(
+
+// Update the demands and the execution time from the loads of the connected common resources
+void schd_exec_c::demand_update( void ) {
+   schd_sig_ptree_c pt_out;
+
+   // Update demand for the common resource if there are changes
+   BOOST_FOREACH( cres_data_t& cres_el, cres_list ) {
+      if( cres_el.state != CRES_STATE_CONNECTED ) {
+         continue;
+      }
+
+      double exec_demand_new;
+
+      if(( cres_load_max <= 1.0 ) ||
+         ( cres_load_max == cres_el.cres_load )) {
+         // Don't change the demand if the resource is not demanded above the capacity
+         // Don't change the demand for the resource with the max load
+         exec_demand_new = cres_el.plan_demand;
+      }
+      else {
+         // Reduce the demand for the resources other than one with max load.
+         // This models the demand while execution block is stalled by the shortage of supply
+         exec_demand_new = cres_el.plan_demand / cres_load_max;
+      }
+
+      // Check if the reported demand has changed
+      if( cres_el.exec_demand != exec_demand_new ) {
+         cres_el.exec_demand = exec_demand_new;
+
+         // Notify common resource from the list on the new demand
+         std::shared_ptr<schd_msg_exec_cres_t> exec_msg_p = std::make_shared<schd_msg_exec_cres_t>();
+
+         exec_msg_p->src       = exec_id;              // ID of this exec
+         exec_msg_p->dst.push_back( cres_el.id );      // Common resource to update
+         exec_msg_p->connected = true;                 // Connected
+         exec_msg_p->demand    = exec_demand_new;      // Demand
+
+         cres_o->write( pt_out.set( exec_msg_p )); // Write data to the output
+
+         // Dump pt packets as they depart from the output of the block
+         schd_msg_dump( dump_buf_cres_o, *exec_msg_p );
+      } // if( cres_el.exec_demand != exec_demand_new )  ...
+   } // BOOST_FOREACH( cres_data_t& cres_el, cres_list )
+
+   // Update time to go
+   double time_ext_coe_new = std::max( cres_load_max, 1.0 );
+
+   if( time_ext_coe != time_ext_coe_new ) {
+      if( time_exact_en ) {
+         time_to_go = work.ext_set( time_ext_coe_new );
+      }
+      else {
+         time_to_go = ( time_to_go - ( sc_core::sc_time_stamp() - time_upd )) / time_ext_coe * time_ext_coe_new;
+      }
+
+      time_upd   = sc_core::sc_time_stamp();
+
+      time_ext_coe = time_ext_coe_new;
+
+      exec_complete.cancel();
+      exec_complete.notify( time_to_go );
+   } // if( time_ext_coe != time_ext_coe_new )
+} // schd_exec_c::demand_update(
+
+schd_exec_c::cres_list_t::iterator schd_exec_c::cres_find(
+      std::size_t id ) {
+
+   return std::find_if(
+         cres_list.begin(),
+         cres_list.end(),
+         [id]( const cres_data_t& el )->bool {
+            return el.id == id; } );
+} // schd_exec_c::cres_find(
+
+// Update the load and the max load. Full scan only if the max has decreased
+void schd_exec_c::cres_load_set(
+      cres_data_t& cres_data,
+      double       cres_load ) {
+
+   double cres_load_prev = cres_data.cres_load;
+   cres_data.cres_load = cres_load;
+
+   if( cres_load >= cres_load_max ) {
+      cres_load_max = cres_load;
+   }
+   else if( cres_load_prev == cres_load_max ) {
+      cres_load_max = 0.0;
+
+      BOOST_FOREACH( const cres_data_t& cres_el, cres_list ) {
+         cres_load_max = std::max( cres_load_max, cres_el.cres_load );
+      }
+   }
+} // schd_exec_c::cres_load_set(
+
+void schd_exec_c::trace_update(
+      const cres_data_t& cres_data ) {
+
+   if( !cres_trace_list.empty()) {
+      cres_trace_list.at( cres_data.id ) = cres_data;
+   }
+} // schd_exec_c::trace_update(
 
 } // namespace schd
@@ -0,0 +1,253 @@
+/*
+ * schd_msg.cpp
+ *
+ *  Description:
+ *    Typed messages between the planner, exec and cres blocks
+ */
+
+#include <boost/foreach.hpp>
+#include <boost/functional/hash.hpp>
+#include "schd_msg.h"
+#include "schd_ptree_time.h"
+#include "schd_assert.h"
+#include "schd_report.h"
+
+namespace schd {
+
+schd_msg_ids_c schd_msg_ids;
+
+void schd_msg_ids_c::init(
+      boost::optional<const boost_pt::ptree&> _exec_p,
+      boost::optional<const boost_pt::ptree&> _cres_p,
+      boost::optional<const boost_pt::ptree&> _thrd_p,
+      boost::optional<const boost_pt::ptree&> _task_p ) {
+
+   sym_add( _exec_p, exec_sym, "exec"     );
+   sym_add( _cres_p, cres_sym, "resource" );
+   sym_add( _thrd_p, thrd_sym, "thread"   );
+   sym_add( _task_p, task_sym, "task"     );
+} // schd_msg_ids_c::init(
+
+void schd_msg_ids_c::sym_add(
+      boost::optional<const boost_pt::ptree&> _list_p,
+      sym_table_t&                            sym,
+      const std::string&                      sym_type ) {
+
+   if( !_list_p.is_initialized()) {
+      return;
+   }
+
+   BOOST_FOREACH( const boost_pt::ptree::value_type& list_el, _list_p.get()) {
+      boost::optional<std::string> name_p = list_el.second.get_optional<std::string>("name");
+
+      if( !list_el.first.empty() || !name_p.is_initialized()) {
+         SCHD_REPORT_ERROR( "schd::msg" ) << "Incorrect " << sym_type << " structure";
+      }
+
+      // The first one is used in case of the duplicate names. Duplicates are reported by the blocks
+      sym.id_map.emplace( std::make_pair( name_p.get(), sym.name_list.size()));
+      sym.name_list.push_back( name_p.get());
+   }
+} // schd_msg_ids_c::sym_add(
+
+std::size_t schd_msg_ids_c::sym_id(
+      const sym_table_t& sym,
+      const std::string& sym_type,
+      const std::string& name ) const {
+   std::unordered_map<std::string, std::size_t>::const_iterator id_it = sym.id_map.find( name );
+
+   if( id_it == sym.id_map.end()) {
+      SCHD_REPORT_ERROR( "schd::msg" ) << "Unexpected " << sym_type << " name: " << name;
+   }
+
+   return id_it->second;
+} // schd_msg_ids_c::sym_id(
+
+std::size_t schd_msg_ids_c::exec_id(
+      const std::string& name ) const {
+   return sym_id( exec_sym, "exec", name );
+} // schd_msg_ids_c::exec_id(
+
+std::size_t schd_msg_ids_c::cres_id(
+      const std::string& name ) const {
+   return sym_id( cres_sym, "resource", name );
+} // schd_msg_ids_c::cres_id(
+
+std::size_t schd_msg_ids_c::thrd_id(
+      const std::string& name ) const {
+   return sym_id( thrd_sym, "thread", name );
+} // schd_msg_ids_c::thrd_id(
+
+std::size_t schd_msg_ids_c::task_id(
+      const std::string& name ) const {
+   return sym_id( task_sym, "task", name );
+} // schd_msg_ids_c::task_id(
+
+const std::string& schd_msg_ids_c::exec_name(
+      std::size_t id ) const {
+   return exec_sym.name_list.at( id );
+} // schd_msg_ids_c::exec_name(
+
+const std::string& schd_msg_ids_c::cres_name(
+      std::size_t id ) const {
+   return cres_sym.name_list.at( id );
+} // schd_msg_ids_c::cres_name(
+
+const std::string& schd_msg_ids_c::thrd_name(
+      std::size_t id ) const {
+   return thrd_sym.name_list.at( id );
+} // schd_msg_ids_c::thrd_name(
+
+const std::string& schd_msg_ids_c::task_name(
+      std::size_t id ) const {
+   return task_sym.name_list.at( id );
+} // schd_msg_ids_c::task_name(
+
+std::size_t schd_msg_ids_c::exec_size(
+      void ) const {
+   return exec_sym.name_list.size();
+} // schd_msg_ids_c::exec_size(
+
+std::size_t schd_msg_ids_c::cres_size(
+      void ) const {
+   return cres_sym.name_list.size();
+} // schd_msg_ids_c::cres_size(
+
+void schd_msg_plan_exec_t::to_ptree(
+      boost_pt::ptree& pt ) const {
+   boost_pt::ptree cres_list_pt;
+   boost_pt::ptree exec_list_pt;
+
+   BOOST_FOREACH( std::size_t exec_id, dst ) {
+      exec_list_pt.push_back( std::make_pair( "", boost_pt::ptree().put( "", schd_msg_ids.exec_name( exec_id ))));
+   }
+
+   BOOST_FOREACH( const cres_t& cres_el, cres_list ) {
+      boost_pt::ptree cres_pt;
+
+      cres_pt.put( "res",    schd_msg_ids.cres_name( cres_el.id ));
+      cres_pt.put( "demand", cres_el.demand );
+
+      cres_list_pt.push_back( std::make_pair( "", cres_pt ));
+   }
+
+   pt.clear();
+   pt.put(      "src",     "planner"      );   // Planner
+   pt.put(      "thread",  schd_msg_ids.thrd_name( thrd_id ));   // Thread name
+   pt.put(      "task",    schd_msg_ids.task_name( task_id ));   // Task   name
+   pt.put(      "runtime", runtime        );   // Runtime
+   pt.put_child("param",   param.get()    );   // Parameters
+   pt.put_child("dst",     exec_list_pt   );   // Name of the exec block to update
+   pt.put_child("common",  cres_list_pt   );   // Common resources
+   pt.put_child("options", options.get()  );   // exec options
+} // schd_msg_plan_exec_t::to_ptree(
+
+std::size_t schd_msg_plan_exec_t::hash(
+      void ) const {
+   std::size_t seed = 0;
+
+   boost::hash_combine( seed, thrd_id );
+   boost::hash_combine( seed, task_id );
+
+   // Parameters are identified by their ID. Same value in every run
+   if( param.is_initialized()) {
+      boost::hash_combine( seed, param.get().get<std::string>( "id", "" ));
+   }
+
+   boost::hash_combine( seed, runtime.value());
+   boost::hash_range(   seed, dst.begin(), dst.end());
+
+   BOOST_FOREACH( const cres_t& cres_el, cres_list ) {
+      boost::hash_combine( seed, cres_el.id );
+      boost::hash_combine( seed, cres_el.demand );
+   }
+
+   return seed;
+} // schd_msg_plan_exec_t::hash(
+
+void schd_msg_exec_plan_t::to_ptree(
+      boost_pt::ptree& pt ) const {
+   boost_pt::ptree dst_list_pt;
+
+   dst_list_pt.push_back( std::make_pair( "", boost_pt::ptree().put( "", "planner" ) ));
+
+   pt.clear();
+   pt.put(       "src",  schd_msg_ids.exec_name( src ));  // Name of the executor
+   pt.put_child( "dst",  dst_list_pt );                   // Destination: planner
+} // schd_msg_exec_plan_t::to_ptree(
+
+std::size_t schd_msg_exec_plan_t::hash(
+      void ) const {
+   std::size_t seed = 0;
+
+   boost::hash_combine( seed, src );
+
+   return seed;
+} // schd_msg_exec_plan_t::hash(
+
+void schd_msg_exec_cres_t::to_ptree(
+      boost_pt::ptree& pt ) const {
+   boost_pt::ptree dst_list_pt;
+
+   BOOST_FOREACH( std::size_t cres_id, dst ) {
+      dst_list_pt.push_back( std::make_pair( "", boost_pt::ptree().put( "", schd_msg_ids.cres_name( cres_id ))));
+   }
+
+   pt.clear();
+   pt.put(      "src",       schd_msg_ids.exec_name( src )); // Name of the exec
+   pt.put_child("dst",       dst_list_pt );                  // Common resources to update
+   pt.put(      "connected", connected   );                  // Connection state
+   pt.put(      "demand",    demand      );                  // Resource demand from the exec
+} // schd_msg_exec_cres_t::to_ptree(
+
+std::size_t schd_msg_exec_cres_t::hash(
+      void ) const {
+   std::size_t seed = 0;
+
+   boost::hash_combine( seed, src );
+   boost::hash_range(   seed, dst.begin(), dst.end());
+   boost::hash_combine( seed, connected );
+   boost::hash_combine( seed, demand );
+
+   return seed;
+} // schd_msg_exec_cres_t::hash(
+
+void schd_msg_cres_exec_t::to_ptree(
+      boost_pt::ptree& pt ) const {
+   boost_pt::ptree dst_list_pt;
+
+   BOOST_FOREACH( std::size_t exec_id, dst ) {
+      dst_list_pt.push_back( std::make_pair( "", boost_pt::ptree().put( "", schd_msg_ids.exec_name( exec_id ))));
+   }
+
+   pt.clear();
+   pt.put(      "src",       schd_msg_ids.cres_name( src )); // Name of the resource
+   pt.put_child("dst",       dst_list_pt );                  // Update all exec units involved
+   pt.put(      "demand",    demand      );                  // Resource demand
+   pt.put(      "connected", connected   );                  // Connected state
+} // schd_msg_cres_exec_t::to_ptree(
+
+std::size_t schd_msg_cres_exec_t::hash(
+      void ) const {
+   std::size_t seed = 0;
+
+   boost::hash_combine( seed, src );
+   boost::hash_range(   seed, dst.begin(), dst.end());
+   boost::hash_combine( seed, demand );
+   boost::hash_combine( seed, connected );
+
+   return seed;
+} // schd_msg_cres_exec_t::hash(
+
+schd_dump_buf_wret_t schd_msg_dump(
+      schd_dump_buf_c<boost_pt::ptree>& buf,
+      const schd_msg_c&                 msg ) {
+   return buf.write_lazy(
+         [&msg]()->boost_pt::ptree {
+            boost_pt::ptree pt;
+            msg.to_ptree( pt );
+            return pt; },
+         BUF_WRITE_LAST );
+} // schd_msg_dump(
+
+} // namespace schd
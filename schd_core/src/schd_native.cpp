@@ -0,0 +1,776 @@
+/*
+ * schd_native.cpp
+ *
+ *  Description:
+ *    Native simulation engine.
+ *    Reproduces the message exchange of the planner, exec and cres modules without
+ *    the xbars, fifos and per-module processes. A delta cycle of the SystemC model
+ *    corresponds to a round of the engine in which all the blocks with pending input
+ *    are processed. Time is advanced to the nearest exec completion in the calendar.
+ */
+
+#include <algorithm>
+#include <iterator>
+#include <boost/foreach.hpp>
+#include "schd_native.h"
+#include "schd_conv_ptree.h"
+#include "schd_sum.h"
+#include "schd_trace.h"
+#include "schd_assert.h"
+#include "schd_report.h"
+
+namespace schd {
+
+SC_HAS_PROCESS( schd::schd_native_c );
+schd_native_c::schd_native_c(
+      sc_core::sc_module_name nm )
+   : sc_core::sc_module( nm ) {
+
+   // Process registrations
+   SC_THREAD( exec_thrd );
+}
+
+void schd_native_c::init(
+      boost::optional<const boost_pt::ptree&> _exec_p,
+      boost::optional<const boost_pt::ptree&> _cres_p,
+      boost::optional<const boost_pt::ptree&> _core_p,
+      schd_planner_c&                         _plan ) {
+
+   // Engine options
+   if( _core_p.is_initialized()) {
+      boost::optional<std::string> cres_p = _core_p.get().get_optional<std::string>("cres");
+
+      if( !cres_p.is_initialized() || cres_p.get() == "handshake" ) {
+         cres_solver_en = false;
+      }
+      else if( cres_p.get() == "solver" ) {
+         cres_solver_en = true;
+      }
+      else {
+         SCHD_REPORT_ERROR( "schd::native" ) << name() <<  " Unsupported contention model: " << cres_p.get();
+      }
+
+      boost::optional<bool> time_exact_p = _core_p.get().get_optional<bool>("time_exact");
+
+      time_exact_en = time_exact_p.is_initialized() && time_exact_p.get();
+   }
+
+   // Create exec instances
+   BOOST_FOREACH( const boost_pt::ptree::value_type& exec_el, _exec_p.get()) {
+      if( !exec_el.first.empty()) {
+         SCHD_REPORT_ERROR( "schd::native" ) << name() <<  " Incorrect structure";
+      }
+
+      boost::optional<std::string> name_p = exec_el.second.get_optional<std::string>("name");
+
+      if( !name_p.is_initialized() ) {
+         SCHD_REPORT_ERROR( "schd::native" ) << name() <<  " Incorrect exec name";
+      }
+      else if( exec_idx_map.find( name_p.get()) != exec_idx_map.end()) {
+         SCHD_REPORT_ERROR( "schd::native" ) << name() <<  " Duplicate exec name: " << name_p.get();
+      }
+      else if( schd_msg_ids.exec_id( name_p.get()) != exec_list.size()) {
+         SCHD_REPORT_ERROR( "schd::native" ) << name() <<  " Inconsistent exec ID: " << name_p.get();
+      }
+
+      exec_data_t exec_data;
+
+      exec_data.name = name_p.get();
+      exec_data.dump_buf_plan_i = new schd_dump_buf_c<boost_pt::ptree>( exec_data.name + ".plan_i" );
+      exec_data.dump_buf_plan_o = new schd_dump_buf_c<boost_pt::ptree>( exec_data.name + ".plan_o" );
+      exec_data.dump_buf_cres_i = new schd_dump_buf_c<boost_pt::ptree>( exec_data.name + ".cres_i" );
+      exec_data.dump_buf_cres_o = new schd_dump_buf_c<boost_pt::ptree>( exec_data.name + ".cres_o" );
+
+      exec_idx_map.emplace( std::make_pair( exec_data.name, exec_list.size()));
+      exec_list.push_back( exec_data );
+   } // BOOST_FOREACH( const boost_pt::ptree::value_type& exec_el, _exec_p.get())
+
+   // Create cres instances
+   BOOST_FOREACH( const boost_pt::ptree::value_type& cres_el, _cres_p.get()) {
+      if( !cres_el.first.empty()) {
+         SCHD_REPORT_ERROR( "schd::native" ) << name() <<  " Incorrect structure";
+      }
+
+      boost::optional<std::string> name_p = cres_el.second.get_optional<std::string>("name");
+      boost::optional<double>      capa_p = cres_el.second.get_optional<double>("capacity");
+
+      if( !name_p.is_initialized() ||
+          !capa_p.is_initialized()) {
+         SCHD_REPORT_ERROR( "schd::native" ) << name() <<  " Incorrect cres structure";
+      }
+      else if( cres_idx_map.find( name_p.get()) != cres_idx_map.end()) {
+         SCHD_REPORT_ERROR( "schd::native" ) << name() <<  " Duplicate cres name: " << name_p.get();
+      }
+      else if( schd_msg_ids.cres_id( name_p.get()) != cres_list.size()) {
+         SCHD_REPORT_ERROR( "schd::native" ) << name() <<  " Inconsistent cres ID: " << name_p.get();
+      }
+
+      if( capa_p.get() <= 0.0 ) {
+         SCHD_REPORT_ERROR( "schd::native" ) << name() << " Incorrect capacity specification";
+      }
+
+      cres_data_t cres_data;
+
+      cres_data.name     = name_p.get();
+      cres_data.capacity = capa_p.get();
+      cres_data.exec_list.resize( exec_list.size());
+      cres_data.dump_buf_exec_i = new schd_dump_buf_c<boost_pt::ptree>( cres_data.name + ".exec_i" );
+      cres_data.dump_buf_exec_o = new schd_dump_buf_c<boost_pt::ptree>( cres_data.name + ".exec_o" );
+
+      cres_idx_map.emplace( std::make_pair( cres_data.name, cres_list.size()));
+      cres_list.push_back( cres_data );
+   } // BOOST_FOREACH( const boost_pt::ptree::value_type& cres_el, _cres_p.get())
+
+   // Each exec keeps the state of all common resources
+   BOOST_FOREACH( exec_data_t& exec_data, exec_list ) {
+      exec_data.cres_list.resize( cres_list.size());
+
+      for( std::size_t cres_idx = 0; cres_idx < cres_list.size(); cres_idx ++ ) {
+         exec_data.cres_list.at( cres_idx ).capacity = cres_list.at( cres_idx ).capacity;
+      }
+   }
+
+   // Order of the names
+   BOOST_FOREACH( const idx_map_t::value_type& el, exec_idx_map ) {
+      exec_ord.push_back( el.second );
+   }
+
+   BOOST_FOREACH( const idx_map_t::value_type& el, cres_idx_map ) {
+      cres_ord.push_back( el.second );
+   }
+
+   exec_act.resize( exec_list.size());
+   cres_act.resize( cres_list.size());
+
+   // Centralized solver uses the same order of the names for the accumulation of the demand
+   if( cres_solver_en ) {
+      std::vector<double>      cres_cap;
+      std::vector<std::size_t> exec_rank( exec_list.size());
+      std::vector<std::size_t> cres_rank( cres_list.size());
+
+      BOOST_FOREACH( const cres_data_t& cres_data, cres_list ) {
+         cres_cap.push_back( cres_data.capacity );
+      }
+
+      for( std::size_t ord_idx = 0; ord_idx < exec_ord.size(); ord_idx ++ ) {
+         exec_rank.at( exec_ord.at( ord_idx )) = ord_idx;
+      }
+
+      for( std::size_t ord_idx = 0; ord_idx < cres_ord.size(); ord_idx ++ ) {
+         cres_rank.at( cres_ord.at( ord_idx )) = ord_idx;
+      }
+
+      cres_solver.init( cres_cap, exec_rank, cres_rank );
+   }
+
+   // Take over the output of the planner
+   plan_p = boost::optional<schd_planner_c&>( _plan );
+   plan_p.get().plan_write_f = [this]( const schd_msg_plan_exec_ptr& plan_msg ) {
+      plan_route( plan_msg ); };
+
+   add_trace( schd_trace.tf, name());
+} // schd_native_c::init(
+
+void schd_native_c::add_trace(
+      sc_core::sc_trace_file* tf,
+      const std::string& top_name ) {
+
+   // Same names as for the exec and cres modules
+   BOOST_FOREACH( std::size_t exec_idx, exec_ord ) {
+      exec_data_t& exec_data = exec_list.at( exec_idx );
+      std::string  mod_name  = top_name + "." + exec_data.name + ".";
+
+      BOOST_FOREACH( std::size_t cres_idx, cres_ord ) {
+         exec_cres_t&       cres_el   = exec_data.cres_list.at( cres_idx );
+         const std::string& cres_name = cres_list.at( cres_idx ).name;
+
+         sc_core::sc_trace( tf, &( cres_el.capacity    ), mod_name + cres_name + ".capacity"    );
+         sc_core::sc_trace( tf, &( cres_el.connected   ), mod_name + cres_name + ".connected"   );
+         sc_core::sc_trace( tf, &( cres_el.cres_demand ), mod_name + cres_name + ".cres_demand" );
+         sc_core::sc_trace( tf, &( cres_el.cres_load   ), mod_name + cres_name + ".cres_load"   );
+         sc_core::sc_trace( tf, &( cres_el.plan_demand ), mod_name + cres_name + ".plan_demand" );
+         sc_core::sc_trace( tf, &( cres_el.exec_demand ), mod_name + cres_name + ".exec_demand" );
+      }
+
+      sc_core::sc_trace( tf, &( exec_data.job_hash ), mod_name + "job_hash" );
+   }
+
+   BOOST_FOREACH( std::size_t cres_idx, cres_ord ) {
+      cres_data_t& cres_data = cres_list.at( cres_idx );
+      std::string  mod_name  = top_name + "." + cres_data.name + ".";
+
+      BOOST_FOREACH( std::size_t exec_idx, exec_ord ) {
+         cres_exec_t&       exec_el   = cres_data.exec_list.at( exec_idx );
+         const std::string& exec_name = exec_list.at( exec_idx ).name;
+
+         sc_core::sc_trace( tf, &( exec_el.connected ), mod_name + exec_name + ".connected" );
+         sc_core::sc_trace( tf, &( exec_el.demand    ), mod_name + exec_name + ".demand"    );
+      }
+
+      sc_core::sc_trace( tf, &( cres_data.demand   ), mod_name + "demand"   );
+      sc_core::sc_trace( tf, &( cres_data.capacity ), mod_name + "capacity" );
+   }
+} // schd_native_c::add_trace(
+
+void schd_native_c::exec_thrd( void ) {
+   sc_core::wait(sc_core::SC_ZERO_TIME);
+
+   // Register start event at #0
+   plan_p.get().event_add( 0 ); // "__start__"
+   plan_p.get().plan_update();
+
+   for(;;) {
+      // Delta cycles at the current time
+      while( plan_act || exec_act.any() || cres_act.any()) {
+         // Inputs of the current delta. Outputs of the blocks go to the next delta
+         std::vector<schd_msg_exec_plan_ptr> plan_c;
+         bool plan_run = plan_act;
+
+         plan_c.swap( plan_i );
+         plan_act = false;
+
+         boost::dynamic_bitset<> exec_run = exec_act;
+         boost::dynamic_bitset<> cres_run = cres_act;
+
+         exec_act.reset();
+         cres_act.reset();
+
+         for( std::size_t exec_idx = exec_run.find_first();
+                          exec_idx < exec_run.size();
+                          exec_idx = exec_run.find_next( exec_idx )) {
+            exec_list.at( exec_idx ).plan_c.swap( exec_list.at( exec_idx ).plan_i );
+            exec_list.at( exec_idx ).cres_c.swap( exec_list.at( exec_idx ).cres_i );
+         }
+
+         for( std::size_t cres_idx = cres_run.find_first();
+                          cres_idx < cres_run.size();
+                          cres_idx = cres_run.find_next( cres_idx )) {
+            cres_list.at( cres_idx ).exec_c.swap( cres_list.at( cres_idx ).exec_i );
+         }
+
+         // Planner
+         if( plan_run ) {
+            BOOST_FOREACH( const schd_msg_exec_plan_ptr& core_msg_inp, plan_c ) {
+               plan_p.get().plan_complete( *core_msg_inp );
+            }
+
+            plan_p.get().plan_update();
+         }
+
+         // Execution blocks
+         for( std::size_t exec_idx = exec_run.find_first();
+                          exec_idx < exec_run.size();
+                          exec_idx = exec_run.find_next( exec_idx )) {
+            exec_proc( exec_idx );
+         }
+
+         // Resolve the contention for all the tasks which have started or ended in this delta
+         if( cres_solver_pend ) {
+            cres_solve();
+         }
+
+         // Common resources
+         for( std::size_t cres_idx = cres_run.find_first();
+                          cres_idx < cres_run.size();
+                          cres_idx = cres_run.find_next( cres_idx )) {
+            cres_proc( cres_idx );
+         }
+      } // while( plan_act || exec_act.any() || cres_act.any())
+
+      // Remove the completions which were re-scheduled
+      while( !calendar.empty() &&
+             calendar.begin()->second.second != exec_list.at( calendar.begin()->second.first ).time_gen ) {
+         calendar.erase( calendar.begin());
+      }
+
+      if( calendar.empty()) {
+         break; // Nothing else to simulate
+      }
+
+      // Advance time to the nearest completion
+      sc_core::sc_time time_next = calendar.begin()->first;
+
+      sc_core::wait( time_next - sc_core::sc_time_stamp());
+
+      while( !calendar.empty() && calendar.begin()->first == time_next ) {
+         std::size_t exec_idx = calendar.begin()->second.first;
+
+         if( calendar.begin()->second.second == exec_list.at( exec_idx ).time_gen ) {
+            exec_list.at( exec_idx ).complete = true;
+            exec_act[exec_idx] = true;
+         }
+
+         calendar.erase( calendar.begin());
+      }
+   } // for(;;)
+} // schd_native_c::exec_thrd(
+
+// Messages are routed directly. The cross bars and their dump points are not modelled
+void schd_native_c::plan_route(
+      const schd_msg_plan_exec_ptr& plan_msg ) {
+   if( plan_msg->dst.empty()) {
+      SCHD_REPORT_ERROR( "schd::native" ) << name() << " Destination not found";
+   }
+
+   BOOST_FOREACH( std::size_t exec_idx, plan_msg->dst ) {
+      if( exec_idx >= exec_list.size()) {
+         SCHD_REPORT_ERROR( "schd::native" ) << name() << " Destination not found: #" << exec_idx;
+      }
+
+      exec_list.at( exec_idx ).plan_i.push_back( plan_msg );
+      exec_act[exec_idx] = true;
+   }
+} // schd_native_c::plan_route(
+
+void schd_native_c::exec_send_cres(
+      exec_data_t& exec,
+      std::size_t  exec_idx,
+      const std::vector<std::size_t>& dst_list,
+      bool         connected,
+      double       demand ) {
+   std::shared_ptr<schd_msg_exec_cres_t> exec_msg = std::make_shared<schd_msg_exec_cres_t>();
+
+   exec_msg->src       = exec_idx;    // ID of this exec
+   exec_msg->dst       = dst_list;    // Common resources to update
+   exec_msg->connected = connected;   // Connection state
+   exec_msg->demand    = demand;      // Resource demand from this execution block
+
+   BOOST_FOREACH( std::size_t cres_idx, dst_list ) {
+      cres_list.at( cres_idx ).exec_i.push_back( exec_msg );
+      cres_act[cres_idx] = true;
+   }
+
+   // Dump pt packets as they depart from the output of the block
+   schd_msg_dump( *exec.dump_buf_cres_o, *exec_msg );
+} // schd_native_c::exec_send_cres(
+
+void schd_native_c::exec_send_plan(
+      exec_data_t& exec,
+      std::size_t  exec_idx ) {
+   std::shared_ptr<schd_msg_exec_plan_t> exec_msg = std::make_shared<schd_msg_exec_plan_t>();
+
+   exec_msg->src = exec_idx;  // ID of this executor
+
+   plan_i.push_back( exec_msg );
+   plan_act = true;
+
+   // Dump pt packets as they depart from the output of the block
+   schd_msg_dump( *exec.dump_buf_plan_o, *exec_msg );
+} // schd_native_c::exec_send_plan(
+
+void schd_native_c::cres_send_exec(
+      cres_data_t& cres,
+      std::size_t  cres_idx,
+      const std::vector<std::size_t>& dst_list,
+      bool         connected ) {
+   std::shared_ptr<schd_msg_cres_exec_t> cres_msg = std::make_shared<schd_msg_cres_exec_t>();
+
+   cres_msg->src       = cres_idx;      // ID of this resource
+   cres_msg->dst       = dst_list;      // Update all exec units involved
+   cres_msg->demand    = cres.demand;   // Resource demand
+   cres_msg->connected = connected;     // Connected state
+
+   BOOST_FOREACH( std::size_t exec_idx, dst_list ) {
+      exec_list.at( exec_idx ).cres_i.push_back( cres_msg );
+      exec_act[exec_idx] = true;
+   }
+
+   // Dump pt packets as they depart from the output of the block
+   schd_msg_dump( *cres.dump_buf_exec_o, *cres_msg );
+} // schd_native_c::cres_send_exec(
+
+void schd_native_c::exec_schedule(
+      exec_data_t& exec,
+      std::size_t  exec_idx ) {
+   // Entries with the previous generation are discarded when they reach the head of the calendar
+   exec.time_gen ++;
+
+   calendar.emplace( std::make_pair(
+         sc_core::sc_time_stamp() + exec.time_to_go,
+         std::make_pair( exec_idx, exec.time_gen )));
+} // schd_native_c::exec_schedule(
+
+void schd_native_c::exec_proc(
+      std::size_t exec_idx ) {
+   exec_data_t& exec = exec_list.at( exec_idx );
+
+   // Check if there is new data from the planner
+   BOOST_FOREACH( const schd_msg_plan_exec_ptr& plan_msg_p, exec.plan_c ) {
+      const schd_msg_plan_exec_t& plan_msg = *plan_msg_p;
+
+      // Extract data from the received message
+      if( !plan_msg.param.is_initialized()) {
+         SCHD_REPORT_ERROR( "schd::native" ) << exec.name << " Incorrect data format from planner";
+      }
+
+      boost::optional<std::string> prid_p = plan_msg.param.get().get_optional<std::string>("id");
+
+      if( !prid_p.is_initialized() ) {
+         std::string     plan_pt_str;
+         boost_pt::ptree plan_pt;
+
+         plan_msg.to_ptree( plan_pt );
+
+         SCHD_REPORT_ERROR( "schd::native" ) << exec.name
+                                             << " Incorrect data format from planner: "
+                                             << pt2str( plan_pt, plan_pt_str );
+      }
+
+      // Dump pt packets as they arrive to the input of the block
+      schd_msg_dump( *exec.dump_buf_plan_i, plan_msg );
+
+      // Save task name
+      if( exec.job_hash == 0 ) {
+         exec.thrd_id   = plan_msg.thrd_id;
+         exec.task_id   = plan_msg.task_id;
+         exec.param_id  = prid_p.get();
+      }
+      else {
+         SCHD_REPORT_ERROR( "schd::native" ) << exec.name
+                                             << " Unexpected request from the planner: "
+                                             << schd_trace.job_comb(
+                                                   schd_msg_ids.thrd_name( plan_msg.thrd_id ),
+                                                   schd_msg_ids.task_name( plan_msg.task_id ),
+                                                   prid_p.get())
+                                             << " while running: "
+                                             << schd_trace.job_comb(
+                                                   schd_msg_ids.thrd_name( exec.thrd_id ),
+                                                   schd_msg_ids.task_name( exec.task_id ),
+                                                   exec.param_id );
+      }
+
+      // Update the list of the common resources and notify common resources
+      std::vector<std::pair<std::size_t, double>> plan_demand;
+
+      BOOST_FOREACH( const schd_msg_plan_exec_t::cres_t& cres_el, plan_msg.cres_list ) {
+         // Check the fields
+         if( cres_el.demand < 0 ) {
+            SCHD_REPORT_ERROR( "schd::native" ) << exec.name << " Incorrect data format from planner";
+         }
+
+         if( cres_el.id >= cres_list.size()) {
+            SCHD_REPORT_ERROR( "schd::native" )
+                  << exec.name
+                  << " Unexpected resorce ID: "
+                  << cres_el.id;
+         }
+         else if( exec.cres_list.at( cres_el.id ).state != CRES_STATE_IDLE ) {
+            SCHD_REPORT_ERROR( "schd::native" )
+                  << exec.name
+                  << " Duplicate connection for: "
+                  << cres_list.at( cres_el.id ).name;
+         }
+
+         // Initialise cres data
+         exec_cres_t& exec_cres = exec.cres_list.at( cres_el.id );
+
+         exec_cres.state       = CRES_STATE_WAIT_CON;
+         exec_cres.cres_demand = 0.0;
+         exec_cres.cres_load   = 0.0;
+         exec_cres.plan_demand = cres_el.demand;
+         exec_cres.exec_demand = cres_el.demand;
+
+         if( cres_solver_en ) {
+            exec_cres.state     = CRES_STATE_CONNECTED;
+            exec_cres.connected = true;
+
+            plan_demand.push_back( std::make_pair( cres_el.id, cres_el.demand ));
+         }
+         else {
+            // Notify common resource on the new demand
+            exec_send_cres( exec, exec_idx, std::vector<std::size_t>( 1, cres_el.id ), true, cres_el.demand );
+         }
+      } // BOOST_FOREACH( const schd_msg_plan_exec_t::cres_t& cres_el, plan_msg.cres_list )
+
+      if( cres_solver_en ) {
+         cres_solver.connect( exec_idx, plan_demand );
+         cres_solver_pend = true;
+      }
+
+      // Update time and run the execution
+      exec.time_to_go   = plan_msg.runtime;
+      exec.time_upd     = sc_core::sc_time_stamp();
+      exec.time_ext_coe = 1.0;
+
+      if( time_exact_en ) {
+         exec.work.start( exec.time_to_go );
+      }
+
+      std::string job_tag = schd_trace.job_comb(
+            schd_msg_ids.thrd_name( plan_msg.thrd_id ),
+            schd_msg_ids.task_name( plan_msg.task_id ),
+            prid_p.get());
+
+      exec.job_hash = 0;
+      boost::hash_combine(
+            exec.job_hash,
+            job_tag  );
+
+      exec_schedule( exec, exec_idx );
+   } // BOOST_FOREACH( const schd_msg_plan_exec_ptr& plan_msg_p, exec.plan_c )
+
+   exec.plan_c.clear();
+
+   // Check if there is new data from common resources
+   BOOST_FOREACH( const schd_msg_cres_exec_ptr& msg_p, exec.cres_c ) {
+      const schd_msg_cres_exec_t& msg = *msg_p;
+
+      // Dump pt packets as they arrive to the input of the block
+      schd_msg_dump( *exec.dump_buf_cres_i, msg );
+
+      exec_cres_t& exec_cres = exec.cres_list.at( msg.src );
+
+      if( exec_cres.state == CRES_STATE_IDLE ) {
+         SCHD_REPORT_ERROR( "schd::native" )
+               << exec.name
+               << " Unexpected update from: "
+               << cres_list.at( msg.src ).name;
+      }
+
+      if( msg.connected && exec_cres.state != CRES_STATE_IDLE &&
+                           exec_cres.state != CRES_STATE_WAIT_DCN ) {
+         exec_cres.state       = CRES_STATE_CONNECTED;
+         exec_cres.connected   = true;
+         exec_cres.cres_demand = msg.demand;
+         exec_cres.cres_load   = msg.demand / exec_cres.capacity;
+
+         double cres_load_max = 0;
+
+         // Find common resource which is loaded at most
+         BOOST_FOREACH( std::size_t cres_idx, cres_ord ) {
+            if( exec.cres_list.at( cres_idx ).state == CRES_STATE_CONNECTED ) {
+               cres_load_max = std::max( cres_load_max, exec.cres_list.at( cres_idx ).cres_load );
+            }
+         }
+
+         // Update demand for the common resource if there are changes
+         BOOST_FOREACH( std::size_t cres_idx, cres_ord ) {
+            exec_cres_t& cres_el = exec.cres_list.at( cres_idx );
+
+            if( cres_el.state != CRES_STATE_CONNECTED ) {
+               continue;
+            }
+
+            double exec_demand_new;
+
+            if(( cres_load_max <= 1.0 ) ||
+               ( cres_load_max == cres_el.cres_load )) {
+               // Don't change the demand if the resource is not demanded above the capacity
+               // Don't change the demand for the resource with the max load
+               exec_demand_new = cres_el.plan_demand;
+            }
+            else {
+               // Reduce the demand for the resources other than one with max load.
+               // This models the demand while execution block is stalled by the shortage of supply
+               exec_demand_new = cres_el.plan_demand / cres_load_max;
+            }
+
+            // Check if the reported demand has changed
+            if( cres_el.exec_demand != exec_demand_new ) {
+               cres_el.exec_demand = exec_demand_new;
+
+               exec_send_cres( exec, exec_idx, std::vector<std::size_t>( 1, cres_idx ), true, exec_demand_new );
+            }
+         } // BOOST_FOREACH( std::size_t cres_idx, cres_ord )
+
+         // Update time to go
+         double time_ext_coe_new = std::max( cres_load_max, 1.0 );
+
+         if( exec.time_ext_coe != time_ext_coe_new ) {
+            if( time_exact_en ) {
+               exec.time_to_go = exec.work.ext_set( time_ext_coe_new );
+            }
+            else {
+               exec.time_to_go = ( exec.time_to_go - ( sc_core::sc_time_stamp() - exec.time_upd )) / exec.time_ext_coe * time_ext_coe_new;
+            }
+
+            exec.time_upd   = sc_core::sc_time_stamp();
+
+            exec.time_ext_coe = time_ext_coe_new;
+
+            exec_schedule( exec, exec_idx );
+         } // if( exec.time_ext_coe != time_ext_coe_new )
+      }
+      else if( !msg.connected && exec_cres.state == CRES_STATE_WAIT_DCN ) {
+         exec_cres.state     = CRES_STATE_IDLE;
+         exec_cres.connected = false;
+
+         if( exec.cres_list.end() == std::find_if(
+               exec.cres_list.begin(),
+               exec.cres_list.end(),
+               []( const exec_cres_t& el )->bool {
+                  return el.state != CRES_STATE_IDLE; } )) {
+            // Notify planner that the execution is complete
+            exec_send_plan( exec, exec_idx );
+         }
+      }
+      else if( msg.connected && exec_cres.state == CRES_STATE_WAIT_DCN ) {
+         ;
+      }
+      else {
+         SCHD_REPORT_ERROR( "schd::native" ) << exec.name << " Unexpected state transition";
+      }
+   } // BOOST_FOREACH( const schd_msg_cres_exec_ptr& msg_p, exec.cres_c )
+
+   exec.cres_c.clear();
+
+   // Check if the execution is complete
+   if( exec.complete ) {
+      exec.complete     = false;
+      exec.time_gen    ++;         // Discard the pending completions
+      exec.time_to_go   = sc_core::SC_ZERO_TIME;
+      exec.time_ext_coe = 1.0;
+
+      std::vector<std::size_t> dst_list;
+
+      BOOST_FOREACH( std::size_t cres_idx, cres_ord ) {
+         exec_cres_t& cres_el = exec.cres_list.at( cres_idx );
+
+         if( cres_el.state != CRES_STATE_IDLE ) {
+            dst_list.push_back( cres_idx );
+
+            if( cres_solver_en ) {
+               cres_list.at( cres_idx ).exec_list.at( exec_idx ).connected = false;
+               cres_list.at( cres_idx ).exec_list.at( exec_idx ).demand    = 0.0;
+            }
+
+            cres_el.state       = cres_solver_en ? CRES_STATE_IDLE : CRES_STATE_WAIT_DCN;
+            cres_el.connected   = cres_solver_en ? false           : cres_el.connected;
+            cres_el.cres_demand = 0.0;
+            cres_el.cres_load   = 0.0;
+            cres_el.plan_demand = 0.0;
+            cres_el.exec_demand = 0.0;
+         }
+      }
+
+      if( cres_solver_en ) {
+         // Disconnect from the solver and notify planner that the execution is complete
+         cres_solver.disconnect( exec_idx );
+         cres_solver_pend = true;
+
+         exec_send_plan( exec, exec_idx );
+      }
+      else if( !dst_list.empty()) {
+         // Notify common resources from the list that the executor now has zero demand
+         exec_send_cres( exec, exec_idx, dst_list, false, 0.0 );
+      }
+      else {
+         exec_send_plan( exec, exec_idx );
+      }
+
+      exec.job_hash = 0;
+   } // if( exec.complete )
+} // schd_native_c::exec_proc(
+
+void schd_native_c::cres_proc(
+      std::size_t cres_idx ) {
+   cres_data_t& cres = cres_list.at( cres_idx );
+
+   BOOST_FOREACH( const schd_msg_exec_cres_ptr& msg_p, cres.exec_c ) {
+      const schd_msg_exec_cres_t& msg = *msg_p;
+
+      // Dump pt packets as they arrive to the input of the block
+      schd_msg_dump( *cres.dump_buf_exec_i, msg );
+
+      if(( !msg.connected && msg.demand > 0 ) || ( msg.demand < 0 )) {
+         SCHD_REPORT_ERROR( "schd::native" )
+               << cres.name
+               << " Data integrity failed from: "
+               << exec_list.at( msg.src ).name;
+      }
+
+      // Update the record for the exec
+      cres_exec_t& cres_exec = cres.exec_list.at( msg.src );
+
+      bool conn_prev = cres_exec.connected;
+      cres_exec.connected = msg.connected;
+      cres_exec.demand    = msg.demand;
+
+      std::vector<std::size_t> dst_list;
+      schd_sum_c               demand_sum;  // Same arithmetic as in schd_cres_c
+
+      BOOST_FOREACH( std::size_t exec_idx, exec_ord ) {
+         if( cres.exec_list.at( exec_idx ).connected ) { // Accumulate demand
+            demand_sum.add( cres.exec_list.at( exec_idx ).demand );
+         }
+      }
+
+      double demand_acc = demand_sum.value();
+
+      // Broadcast updated demand to the exec blocks
+      if( cres.demand != demand_acc ) {
+         cres.demand = demand_acc;
+
+         BOOST_FOREACH( std::size_t exec_idx, exec_ord ) {
+            if( cres.exec_list.at( exec_idx ).connected ) {
+               dst_list.push_back( exec_idx );
+            }
+         }
+      }
+      else if( conn_prev == false && cres_exec.connected == true ) {
+         dst_list.push_back( msg.src );
+      }
+
+      if( !dst_list.empty()) {
+         cres_send_exec( cres, cres_idx, dst_list, true );
+      }
+
+      // Just disconnected
+      if( conn_prev == true && cres_exec.connected == false ) {
+         cres_send_exec( cres, cres_idx, std::vector<std::size_t>( 1, msg.src ), false );
+      }
+   } // BOOST_FOREACH( const schd_msg_exec_cres_ptr& msg_p, cres.exec_c )
+
+   cres.exec_c.clear();
+} // schd_native_c::cres_proc(
+
+void schd_native_c::cres_solve( void ) {
+   std::vector<std::size_t> exec_upd;
+
+   cres_solver_pend = false;
+
+   if( !cres_solver.solve( exec_upd )) {
+      return;
+   }
+
+   // Total demand of the resources, including ones without the connected execs
+   for( std::size_t cres_idx = 0; cres_idx < cres_list.size(); cres_idx ++ ) {
+      cres_list.at( cres_idx ).demand = cres_solver.demand( cres_idx );
+   }
+
+   BOOST_FOREACH( std::size_t exec_idx, exec_upd ) {
+      exec_data_t& exec = exec_list.at( exec_idx );
+
+      // State of the resources as seen by the exec
+      BOOST_FOREACH( const schd_cres_solver_c::link_t& link_el, cres_solver.row( exec_idx )) {
+         exec_cres_t& exec_cres = exec.cres_list.at( link_el.cres_idx );
+
+         exec_cres.cres_demand = cres_solver.demand( link_el.cres_idx );
+         exec_cres.cres_load   = link_el.cres_load;
+         exec_cres.exec_demand = link_el.exec_demand;
+
+         cres_list.at( link_el.cres_idx ).exec_list.at( exec_idx ).connected = true;
+         cres_list.at( link_el.cres_idx ).exec_list.at( exec_idx ).demand    = link_el.exec_demand;
+      }
+
+      // Reschedule the completion only if the time extension has changed
+      double time_ext_coe_new = cres_solver.time_ext_coe( exec_idx );
+
+      if( exec.time_ext_coe != time_ext_coe_new ) {
+         if( time_exact_en ) {
+            exec.time_to_go = exec.work.ext_set( time_ext_coe_new );
+         }
+         else {
+            exec.time_to_go = ( exec.time_to_go - ( sc_core::sc_time_stamp() - exec.time_upd )) / exec.time_ext_coe * time_ext_coe_new;
+         }
+
+         exec.time_upd   = sc_core::sc_time_stamp();
+
+         exec.time_ext_coe = time_ext_coe_new;
+
+         exec_schedule( exec, exec_idx );
+      }
+   } // BOOST_FOREACH( std::size_t exec_idx, exec_upd )
+} // schd_native_c::cres_solve(
+
+} // namespace schd
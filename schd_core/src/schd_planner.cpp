@@ -24,7 +24,9 @@ schd_planner_c::schd_planner_c(
       sc_core::sc_module_name nm )
    : sc_core::sc_module( nm )
    , core_i( "core_i" )
-   , core_o( "core_o" ) {
+   , core_o( "core_o" )
+   , dump_buf_core_i( std::string( name()) + ".core_i" )
+   , dump_buf_core_o( std::string( name()) + ".core_o" ) {
 
    // Process registrations
    SC_THREAD( exec_thrd );
@@ -33,7 +35,23 @@ schd_planner_c::schd_planner_c(
 void schd_planner_c::init(
       boost::optional<const boost_pt::ptree&> _thrd_p,
       boost::optional<const boost_pt::ptree&> _task_p,
-      boost::optional<const boost_pt::ptree&> _exec_p ) {
+      boost::optional<const boost_pt::ptree&> _exec_p,
+      boost::optional<const boost_pt::ptree&> _core_p ) {
+
+   // Engine options
+   if( _core_p.is_initialized()) {
+      boost::optional<std::string> alloc_p = _core_p.get().get_optional<std::string>("alloc");
+
+      if( !alloc_p.is_initialized() || alloc_p.get() == "greedy" ) {
+         alloc_mode = ALLOC_GREEDY;
+      }
+      else if( alloc_p.get() == "matching" ) {
+         alloc_mode = ALLOC_MATCHING;
+      }
+      else {
+         SCHD_REPORT_ERROR( "schd::plan" ) << name() <<  " Unsupported allocation engine: " << alloc_p.get();
+      }
+   }
 
    // Create a list of exec instances
    BOOST_FOREACH( const boost_pt::ptree::value_type& exec_el, _exec_p.get()) {
@@ -53,6 +71,22 @@ void schd_planner_c::init(
       exec_list.emplace( std::make_pair( name_p.get(), exec_data ));
    } // BOOST_FOREACH( const boost_pt::ptree::value_type& exec_el, _exec_p.get())
 
+   // Index the exec instances. All of them are free
+   BOOST_FOREACH( exec_list_t::value_type& exec_el, exec_list ) {
+      exec_el.second.idx = exec_vect.size();
+      exec_vect.push_back( boost::optional<exec_list_t::value_type&>( exec_el ));
+   }
+
+   exec_free.resize( exec_vect.size(), true );
+
+   // IDs which are used in the messages
+   exec_id_vect.resize( schd_msg_ids.exec_size());
+
+   BOOST_FOREACH( exec_list_t::value_type& exec_el, exec_list ) {
+      exec_el.second.id = schd_msg_ids.exec_id( exec_el.first );
+      exec_id_vect.at( exec_el.second.id ) = boost::optional<exec_list_t::value_type&>( exec_el );
+   }
+
    // Task list
    BOOST_FOREACH( const boost_pt::ptree::value_type& task_el, _task_p.get()) {
       if( !task_el.first.empty()) {
@@ -72,6 +106,7 @@ void schd_planner_c::init(
       task_data_t            task_data;
       std::list<std::string> task_cres_list;
 
+      task_data.id       = schd_msg_ids.task_id( name_p.get());
       task_data.run_time = runt_p.get();
 
       BOOST_FOREACH( const boost_pt::ptree::value_type& exec_el, exec_p.get()) {
@@ -101,16 +136,14 @@ void schd_planner_c::init(
             SCHD_REPORT_ERROR( "schd::plan" ) << "Unexpected";
          }
 
-         // Check if at least 1 exec is present for this mask
-         bool exec_avail= false;
+         // Match the mask against the exec names. Check if at least 1 exec is present for this mask
+         task_run_el.exec_bits.resize( exec_vect.size());
+
          BOOST_FOREACH( const exec_list_t::value_type& elst_el, exec_list ) {
-            if( boost::regex_match( elst_el.first, task_run_el.mask_exec )) {
-               exec_avail = true;
-               break;
-            }
+            task_run_el.exec_bits[elst_el.second.idx] = boost::regex_match( elst_el.first, task_run_el.mask_exec );
          }
 
-         if( !exec_avail ) {
+         if( task_run_el.exec_bits.none()) {
             SCHD_REPORT_ERROR( "schd::plan" ) << name() <<  " exec is not found for the task " << name_p.get();
          }
 
@@ -142,6 +175,7 @@ void schd_planner_c::init(
       std::size_t cres_list_idx = 0;
       BOOST_FOREACH( const std::string& cres_el, task_cres_list) {
          task_data.cres_list.at( cres_list_idx ) = std::move( cres_el );
+         task_data.cres_id_list.push_back( schd_msg_ids.cres_id( task_data.cres_list.at( cres_list_idx )));
          cres_list_idx ++;
       }
 
@@ -198,6 +232,7 @@ void schd_planner_c::init(
 
       thrd_data_t thrd_data;
 
+      thrd_data.id       = schd_msg_ids.thrd_id( name_p.get());
       thrd_data.priority = prio_p.get();
 
       // Create list of the ignition events
@@ -281,15 +316,44 @@ void schd_planner_c::init(
       thrd_list.emplace( std::make_pair( name_p.get(), thrd_data ));
    } // BOOST_FOREACH( const boost_pt::ptree::value_type& thrd_el, _thrd_p.get())
 
+   // Assign IDs to the event names. "__start__" gets ID 0
+   std::map<std::string, std::size_t> evnt_id_map;
+
+   BOOST_FOREACH( const std::string& evt_el, evt_check_list ) {
+      if( evnt_id_map.find( evt_el ) == evnt_id_map.end()) {
+         evnt_id_map.emplace( std::make_pair( evt_el, evnt_name_list.size()));
+         evnt_name_list.push_back( evt_el );
+      }
+   }
+
+   BOOST_FOREACH( thrd_list_t::value_type& thrd_el, thrd_list ) {
+      thrd_el.second.idx = thrd_vect.size();
+      thrd_vect.push_back( boost::optional<thrd_list_t::value_type&>( thrd_el ));
+
+      BOOST_FOREACH( thrd_seq_el_t& seq_el, thrd_el.second.seq_list ) {
+         if( !seq_el.task_p.is_initialized()) {
+            seq_el.evnt_id = evnt_id_map.at( seq_el.name );
+         }
+      }
+   } // BOOST_FOREACH( thrd_list_t::value_type& thrd_el, thrd_list )
+
+   // Match the start masks of each thread against the complete list of the event names.
    // Check if there is an event potentially available for the ignition of each thread
-   BOOST_FOREACH( const thrd_list_t::value_type& thrd_el, thrd_list ) {
+   evnt_thrd_bits.assign( evnt_name_list.size(), boost::dynamic_bitset<>( thrd_list.size()));
+   event_bucket.resize( evnt_name_list.size());
+   thrd_dirty.resize( thrd_list.size());
+
+   BOOST_FOREACH( thrd_list_t::value_type& thrd_el, thrd_list ) {
+      thrd_el.second.mask_evnt_any.resize( evnt_name_list.size());
+
       BOOST_FOREACH( const boost::regex& mask_el, thrd_el.second.mask_evnt_list ) {
+         boost::dynamic_bitset<> mask_bits( evnt_name_list.size());
+
+         for( std::size_t evnt_id = 0; evnt_id < evnt_name_list.size(); evnt_id ++ ) {
+            mask_bits[evnt_id] = boost::regex_match( evnt_name_list.at( evnt_id ), mask_el );
+         }
 
-         if( evt_check_list.end() == std::find_if(
-               evt_check_list.begin(),
-               evt_check_list.end(),
-               [mask_el]( const std::string& evt_el )->bool {
-                     return boost::regex_match( evt_el, mask_el ); } )) {
+         if( mask_bits.none()) {
             SCHD_REPORT_ERROR( "schd::plan" )
                   << name()
                   <<  " igniting event is not found for the thread "
@@ -297,216 +361,206 @@ void schd_planner_c::init(
                   << " mask "
                   << mask_el;
          }
-      } // BOOST_FOREACH( const thrd_run_el_t& run_el, thrd_el.second.run_list )
-   } // BOOST_FOREACH( const thrd_list_t::value_type& thrd_el, thrd_list )
+
+         thrd_el.second.mask_evnt_bits.push_back( mask_bits );
+         thrd_el.second.mask_evnt_any |= mask_bits;
+      } // BOOST_FOREACH( const boost::regex& mask_el, thrd_el.second.mask_evnt_list )
+
+      // Register the thread in the lists of the threads affected by each event ID
+      for( std::size_t evnt_id = thrd_el.second.mask_evnt_any.find_first();
+                       evnt_id < evnt_name_list.size();
+                       evnt_id = thrd_el.second.mask_evnt_any.find_next( evnt_id )) {
+         evnt_thrd_bits.at( evnt_id )[thrd_el.second.idx] = true;
+      }
+   } // BOOST_FOREACH( thrd_list_t::value_type& thrd_el, thrd_list )
 
 } // schd_planner_c::init(
 
 void schd_planner_c::exec_thrd( void ) {
    sc_core::wait(sc_core::SC_ZERO_TIME);
 
-   schd_dump_buf_c<boost_pt::ptree> dump_buf_core_i( std::string( name()) + ".core_i" );
-   schd_dump_buf_c<boost_pt::ptree> dump_buf_core_o( std::string( name()) + ".core_o" );
+   // The planner is driven by the native engine. The process is not used
+   if( plan_write_f ) {
+      return;
+   }
 
    // Register start event at #0
-   std::string  start_evnt( "__start__" );
-   event_data_t event_data;
+   event_add( 0 ); // "__start__"
 
-   event_data.name_p     = boost::optional<const std::string&>( start_evnt );
-   event_data.time       = sc_core::sc_time_stamp();
-   event_reg.push_back( event_data );
+   std::vector<schd_sig_ptree_c> sig_inp_list;  // Batch of the input signals
 
    for(;;) {
-      wait_list_t wait_list;
-      std::size_t mask_exec_size = 0;
-
-      // Scan the list of threads to find if any of them can start
-      BOOST_FOREACH( thrd_list_t::value_type& thrd_el, thrd_list ) {
-         // Create a vector of event masks
-         std::vector<boost::optional<const boost::regex&>> mask_evnt_v( thrd_el.second.mask_evnt_list.size() );
-
-         for( std::size_t run_idx = 0; run_idx < thrd_el.second.mask_evnt_list.size(); run_idx ++ ) {
-            mask_evnt_v.at( run_idx ) =
-                  boost::optional<const boost::regex&>( thrd_el.second.mask_evnt_list.at( run_idx ));
-         } // BOOST_FOREACH( const thrd_run_el_t& run_el, thrd_el.second.run_list )
+      plan_update();
 
-         // Create a vector of pointers to the events in the register
-         std::list<boost::optional<event_reg_t::value_type&>> evnt_data_v;
-         boost::optional<const thrd_list_t::value_type&> thrd_el_ptr =
-               boost::optional<const thrd_list_t::value_type&>( thrd_el );
+      sc_core::wait( core_i->data_written_event());
 
-         BOOST_FOREACH( event_data_t& evnt_el, event_reg ) {
-            if(( evnt_el.thrd_caller.get_ptr() != thrd_el_ptr.get_ptr()) &&    // This thread didn't issue the event
-               ( evnt_el.thrd_run_list.end() == std::find_if(     // This thread is not in the "run" list of the event
-                     evnt_el.thrd_run_list.begin(),
-                     evnt_el.thrd_run_list.end(),
-                     [thrd_el_ptr]( const boost::optional<const thrd_list_t::value_type&> &el )->bool {
-                        return el.get_ptr() == thrd_el_ptr.get_ptr(); } )) &&
-               ( evnt_el.thrd_msm_list.end() == std::find_if(     // This thread is not in the "mismatch" list of the event
-                     evnt_el.thrd_msm_list.begin(),
-                     evnt_el.thrd_msm_list.end(),
-                     [thrd_el_ptr]( const boost::optional<const thrd_list_t::value_type&> &el )->bool {
-                        return el.get_ptr() == thrd_el_ptr.get_ptr(); } ))) {
-               evnt_data_v.push_back(
-                     boost::optional<event_reg_t::value_type&>( evnt_el ));
-            }
-         } // BOOST_FOREACH( const event_reg_t::value_type& evnt_el, event_reg )
+      // Read from port
+      sig_inp_list.clear();
+      core_i->read_all( sig_inp_list );
 
-         // Create vector of the pointers to the event names
-         std::vector<boost::optional<const std::string&>> evnt_name_v( evnt_data_v.size());
+      BOOST_FOREACH( const schd_sig_ptree_c& sig_inp, sig_inp_list ) {
+         schd_msg_exec_plan_ptr core_msg_p = sig_inp.msg_as<schd_msg_exec_plan_t>();
 
-         std::size_t evnt_idx = 0;
-         BOOST_FOREACH( boost::optional<event_reg_t::value_type&> evnt_el, evnt_data_v ) {
-            evnt_name_v.at( evnt_idx ) = evnt_el.get().name_p;
-            evnt_idx ++;
+         if( !core_msg_p ) {
+            SCHD_REPORT_ERROR( "schd::plan" ) << name() << " Incorrect data format from exec";
          }
 
-         std::vector<std::size_t> mask_evnt_map_v;
-         std::vector<std::size_t> evnt_mask_cnt_v;
-
-         if( and_list(
-               mask_evnt_v,
-               evnt_name_v,
-               mask_evnt_map_v,
-               evnt_mask_cnt_v )) {
-            if( thrd_el.second.seq_state == SEQ_STATE_IDLE ) {
-               // Thread is waiting for the task at index 0 to get started
-               thrd_el.second.seq_idx   = 0;
-               thrd_el.second.seq_state = SEQ_STATE_WAITING;
-
-               // Update run list for the event and event list in the thread
-               if( !thrd_el.second.evnt_list.empty() ) {
-                  SCHD_REPORT_ERROR( "schd::plan" )
-                                       << name()
-                                       << " Non-empty evnt_list in the thread: "
-                                       << thrd_el.first;
-               }
+         plan_complete( *core_msg_p );
+      } // BOOST_FOREACH( const schd_sig_ptree_c& sig_inp, sig_inp_list )
+   } // for(;;)
+} // schd_planner_c::exec_thrd(
 
-               std::size_t evnt_idx = 0;
+void schd_planner_c::plan_update( void ) {
+   // Scan the threads which can be affected by the new events to find if any of them can start
+   for( std::size_t thrd_idx = thrd_dirty.find_first();
+                    thrd_idx < thrd_dirty.size();
+                    thrd_idx = thrd_dirty.find_next( thrd_idx )) {
+      thrd_list_t::value_type& thrd_el = thrd_vect.at( thrd_idx ).get();
 
-               BOOST_FOREACH( boost::optional<event_reg_t::value_type&> evnt_el, evnt_data_v ) {
-                  if( evnt_mask_cnt_v.at( evnt_idx ) != 0 ) {
-                     evnt_el.get().thrd_run_list.push_back(
-                           boost::optional<const thrd_list_t::value_type&>( thrd_el ));
+      // Collect the events from the buckets of the event IDs which match the start masks
+      std::vector<std::size_t> evnt_slot_v;
+      boost::optional<const thrd_list_t::value_type&> thrd_el_ptr =
+            boost::optional<const thrd_list_t::value_type&>( thrd_el );
 
-                     thrd_el.second.evnt_list.push_back(
-                           boost::optional<event_reg_t::value_type&>( evnt_el ));
-                  }
+      for( std::size_t evnt_id = thrd_el.second.mask_evnt_any.find_first();
+                       evnt_id < thrd_el.second.mask_evnt_any.size();
+                       evnt_id = thrd_el.second.mask_evnt_any.find_next( evnt_id )) {
+         BOOST_FOREACH( std::size_t slot, event_bucket.at( evnt_id )) {
+            const event_data_t& evnt_el = event_reg.at( slot );
 
-                  evnt_idx ++;
-               }
-            }
-            else {
-               SCHD_REPORT_ERROR( "schd::plan" )
-                     << name()
-                     << " Re-start condition for running thread "
-                     << thrd_el.first;
+            if(( evnt_el.thrd_caller.get_ptr() != thrd_el_ptr.get_ptr()) &&    // This thread didn't issue the event
+               ( !evnt_el.thrd_run_bits[thrd_idx] )) {                         // This thread is not in the "run" list of the event
+               evnt_slot_v.push_back( slot );
             }
-         } // if( and_list( ...
-         else {
-            // Update mismatch list for the event
-            std::size_t evnt_idx = 0;
+         }
+      }
 
-            BOOST_FOREACH( boost::optional<event_reg_t::value_type&> evnt_el, evnt_data_v ) {
-               if( evnt_mask_cnt_v.at( evnt_idx ) == 0 ) {
-                  evnt_el.get().thrd_msm_list.push_back(
-                        boost::optional<const thrd_list_t::value_type&>( thrd_el ));
-               }
+      // Restore the order of registration
+      std::sort( evnt_slot_v.begin(), evnt_slot_v.end(),
+            [this]( std::size_t lhs, std::size_t rhs )->bool {
+               return event_reg.at( lhs ).seq < event_reg.at( rhs ).seq; } );
 
-               evnt_idx ++;
-            }
-         } // if( and_list( ... else ...
+      // Create the matrix of matches between the start masks and the events.
+      // Masks are pre-matched against the event IDs in init()
+      std::vector<boost::dynamic_bitset<>> mask_evnt_mat(
+            thrd_el.second.mask_evnt_bits.size(),
+            boost::dynamic_bitset<>( evnt_slot_v.size()));
 
-         // Update waiting list for the execution
-         if( thrd_el.second.seq_state == SEQ_STATE_WAITING ) {
-            wait_data_t wait_data;
+      for( std::size_t mask_idx = 0; mask_idx < mask_evnt_mat.size(); mask_idx ++ ) {
+         const boost::dynamic_bitset<>& mask_bits = thrd_el.second.mask_evnt_bits.at( mask_idx );
+
+         for( std::size_t evnt_idx = 0; evnt_idx < evnt_slot_v.size(); evnt_idx ++ ) {
+            mask_evnt_mat.at( mask_idx )[evnt_idx] = mask_bits[event_reg.at( evnt_slot_v.at( evnt_idx )).name_id];
+         }
+      } // for( std::size_t mask_idx = 0; mask_idx < mask_evnt_mat.size(); mask_idx ++ )
 
-            wait_data.priority = thrd_el.second.priority; // To simplify access when sorting
-            wait_data.thrd_p   = boost::optional<      thrd_list_t::value_type&>( thrd_el );
-            wait_data.task_p   = boost::optional<const task_list_t::value_type&>(
-                  thrd_el.second.seq_list.at( thrd_el.second.seq_idx ).task_p );
+      std::vector<std::size_t> mask_evnt_map_v;
+      std::vector<std::size_t> evnt_mask_cnt_v;
 
-            if( !wait_data.task_p.is_initialized()) {
+      if( and_list(
+            mask_evnt_mat,
+            evnt_slot_v.size(),
+            mask_evnt_map_v,
+            evnt_mask_cnt_v )) {
+         if( thrd_el.second.seq_state == SEQ_STATE_IDLE ) {
+            // Thread is waiting for the task at index 0 to get started
+            thrd_el.second.seq_idx   = 0;
+            thrd_el.second.seq_state = SEQ_STATE_WAITING;
+
+            // Update run list for the event and event list in the thread
+            if( !thrd_el.second.evnt_list.empty() ) {
                SCHD_REPORT_ERROR( "schd::plan" )
-                     << name()
-                     << " Incorrect sequence element "
-                     << thrd_el.second.seq_list.at( thrd_el.second.seq_idx ).name
-                     << " while processing thread "
-                     << thrd_el.first;
+                                    << name()
+                                    << " Non-empty evnt_list in the thread: "
+                                    << thrd_el.first;
             }
 
-            wait_list.push_back( wait_data );
+            for( std::size_t evnt_idx = 0; evnt_idx < evnt_slot_v.size(); evnt_idx ++ ) {
+               if( evnt_mask_cnt_v.at( evnt_idx ) != 0 ) {
+                  event_ref_t   evnt_ref;
+                  event_data_t& evnt_el = event_reg.at( evnt_slot_v.at( evnt_idx ));
+
+                  evnt_el.thrd_run_bits[thrd_idx] = true;
+                  evnt_el.thrd_run_cntr ++;
+
+                  evnt_ref.slot = evnt_slot_v.at( evnt_idx );
+                  evnt_ref.gen  = evnt_el.gen;
+                  thrd_el.second.evnt_list.push_back( evnt_ref );
+               }
+            }
 
-            mask_exec_size += wait_data.task_p.get().second.run_list.size();
-         } // if( thrd_el.second.seq_state == SEQ_STATE_WAITING )
-      } // BOOST_FOREACH( const thrd_list_t::value_type& thrd_el, thrd_list )
+            // Update waiting list for the execution
+            wait_list_add( thrd_el );
+         }
+         else {
+            SCHD_REPORT_ERROR( "schd::plan" )
+                  << name()
+                  << " Re-start condition for running thread "
+                  << thrd_el.first;
+         }
+      } // if( and_list( ...
+   } // for( std::size_t thrd_idx = thrd_dirty.find_first(); ...
 
-      // Sort wait list in the order of descending priority
-      wait_list.sort(
-            []( const wait_list_t::value_type &lhs, wait_list_t::value_type &rhs )->bool {
-               return lhs.priority > rhs.priority; } );
+   thrd_dirty.reset();
 
+   // Allocate execution blocks only if the waiting list or the set of free execution blocks has changed
+   if( alloc_pend && !wait_list.empty() && exec_free.any()) {
+      // Wait list is ordered by descending priority and by the order of arrival for equal priorities.
       // Create vector of masks and update indexes in the wait list
-      std::vector<boost::optional<const boost::regex&>> mask_exec_v( mask_exec_size );
+      std::size_t mask_exec_size = 0;
 
-      std::size_t mask_exec_idx = 0;
+      BOOST_FOREACH( wait_list_t::value_type& wait_pair, wait_list ) {
+         wait_data_t& wait_el = wait_pair.second;
 
-      BOOST_FOREACH( wait_list_t::value_type& wait_el, wait_list ) {
-         wait_el.mask_exec_base = mask_exec_idx;
+         wait_el.mask_exec_base = mask_exec_size;
          wait_el.mask_exec_size = wait_el.task_p.get().second.run_list.size();
 
-         for( std::size_t run_idx = 0; run_idx < wait_el.mask_exec_size; run_idx ++ ) {
-            mask_exec_v.at( mask_exec_idx + run_idx ) = boost::optional<const boost::regex&>(
-                  wait_el.task_p.get().second.run_list.at( run_idx ).mask_exec );
-         }
-
-         mask_exec_idx += wait_el.task_p.get().second.run_list.size();
+         mask_exec_size += wait_el.mask_exec_size;
       }
 
-      // Find available execution blocks
-      std::vector<boost::optional<exec_list_t::value_type&>> exec_data_v;
+      std::vector<boost::dynamic_bitset<>> mask_exec_v( mask_exec_size );
+      std::vector<std::size_t> mask_exec_map_v( mask_exec_v.size());
+      std::vector<std::size_t> exec_mask_cnt_v( exec_vect.size());
+
+      // Matrix of matches between the exec masks and the available exec blocks.
+      // Masks are pre-matched against the exec names in init()
+      BOOST_FOREACH( const wait_list_t::value_type& wait_pair, wait_list ) {
+         const wait_data_t& wait_el = wait_pair.second;
 
-      BOOST_FOREACH( exec_list_t::value_type& exec_el, exec_list ) {
-         if( !exec_el.second.task_p.is_initialized()) {
-            exec_data_v.push_back(
-                  boost::optional<exec_list_t::value_type&>( exec_el ));
+         for( std::size_t run_idx = 0; run_idx < wait_el.mask_exec_size; run_idx ++ ) {
+            mask_exec_v.at( wait_el.mask_exec_base + run_idx ) =
+                  wait_el.task_p.get().second.run_list.at( run_idx ).exec_bits & exec_free;
          }
       }
 
-      // Allocate execution blocks
-      std::vector<boost::optional<const std::string&>> exec_name_v( exec_data_v.size());
-      std::vector<std::size_t> mask_exec_map_v( mask_exec_v.size());
-      std::vector<std::size_t> exec_mask_cnt_v( exec_data_v.size());
+      // Find the longest list of the requests in the order of priority which can be mapped
+      wait_list_t::iterator wait_end  = wait_list.end();
+      std::size_t           wait_size = wait_list.size();
 
-      // Vector of exec names
-      for( std::size_t exec_idx = 0; exec_idx < exec_data_v.size(); exec_idx ++ ) {
-         exec_name_v.at( exec_idx ) = boost::optional<const std::string&>(
-               exec_data_v.at( exec_idx ).get().first );  //
-      }
-
-      while( wait_list.size() != 0 && mask_exec_v.size() != 0 ) {
+      while( wait_size != 0 && mask_exec_v.size() != 0 ) {
          if( and_list(
                mask_exec_v,
-               exec_name_v,
+               exec_vect.size(),
                mask_exec_map_v,
                exec_mask_cnt_v )) { // All requests are mapped to the available exec blocks. Exit.
             break;
          }
          else { // Remove data which corresponds to the lowest priority
-            std::size_t low_prio_base = wait_list.back().mask_exec_base;
-
-            wait_list.resize( wait_list.size() - 1 );
+            wait_end = std::prev( wait_end );
+            wait_size --;
 
-            if( wait_list.size() == 0 ) {
+            if( wait_size == 0 ) {
                break;
             }
 
-            mask_exec_v.resize(     low_prio_base - 1 );
-            mask_exec_map_v.resize( low_prio_base - 1 );
+            mask_exec_v.resize(     wait_end->second.mask_exec_base );
+            mask_exec_map_v.resize( wait_end->second.mask_exec_base );
          }
       }
 
-      BOOST_FOREACH( const wait_list_t::value_type& wait_el, wait_list ) {
+      for( wait_list_t::iterator wait_it = wait_list.begin(); wait_it != wait_end; wait_it ++ ) {
+         const wait_data_t& wait_el = wait_it->second;
+
          if( !wait_el.thrd_p.get().second.exec_list.empty() ) {
             SCHD_REPORT_ERROR( "schd::plan" )
                                  << name()
@@ -514,19 +568,9 @@ void schd_planner_c::exec_thrd( void ) {
                                  << wait_el.thrd_p.get().first;
          }
 
-         boost_pt::ptree  plan_pt;
-         schd_sig_ptree_c pt_out;
-
-         plan_pt.put("src",     name()                               );       // Planner
-         plan_pt.put("thread",  wait_el.thrd_p.get().first           );       // Thread name
-         plan_pt.put("task",    wait_el.task_p.get().first           );       // Task   name
-         plan_pt.put("runtime", wait_el.task_p.get().second.run_time );       // Runtime
-         plan_pt.put_child("param",   wait_el.thrd_p.get().second.seq_list.at(
-               wait_el.thrd_p.get().second.seq_idx ).task_param      );       // Parameters
-
          for( std::size_t exec_idx = 0; exec_idx < wait_el.mask_exec_size; exec_idx ++ ) {
             exec_list_t::value_type& exec_data_r =
-                  exec_data_v.at( mask_exec_map_v.at( wait_el.mask_exec_base + exec_idx )).get();
+                  exec_vect.at( mask_exec_map_v.at( wait_el.mask_exec_base + exec_idx )).get();
 
             exec_data_r.second.time_start = sc_core::sc_time_stamp();
             exec_data_r.second.task_p     = wait_el.task_p;
@@ -534,196 +578,298 @@ void schd_planner_c::exec_thrd( void ) {
             exec_data_r.second.param_p    = boost::optional<const boost_pt::ptree&>(
                   wait_el.thrd_p.get().second.seq_list.at( wait_el.thrd_p.get().second.seq_idx ).task_param );
 
+            exec_free[exec_data_r.second.idx] = false;
+
             wait_el.thrd_p.get().second.exec_list.push_back(
                   boost::optional<const exec_list_t::value_type&>( exec_data_r ));
 
             // Construct data to be sent to the exec blocks
-            boost_pt::ptree  cres_list_pt;
-            boost_pt::ptree  exec_list_pt;
-
-            exec_list_pt.push_back( std::make_pair( "", boost_pt::ptree().put( "", exec_data_r.first ) ));
+            const task_data_t& task_data = exec_data_r.second.task_p.get().second;
 
-            for( std::size_t cres_idx = 0; cres_idx < exec_data_r.second.task_p.get().second.cres_list.size(); cres_idx ++ ) {
-               boost_pt::ptree  cres_pt;
+            std::shared_ptr<schd_msg_plan_exec_t> plan_msg = std::make_shared<schd_msg_plan_exec_t>();
 
-               cres_pt.put( "res",
-                     exec_data_r.second.task_p.get().second.cres_list.at( cres_idx ));
-               cres_pt.put( "demand",
-                     exec_data_r.second.task_p.get().second.run_list.at( exec_idx ).cres_demand.at( cres_idx ));
-
-               cres_list_pt.push_back( std::make_pair( "", cres_pt ));
-            }
+            plan_msg->thrd_id = wait_el.thrd_p.get().second.id;                                      // Thread ID
+            plan_msg->task_id = wait_el.task_p.get().second.id;                                      // Task   ID
+            plan_msg->runtime = task_data.run_time;                                                  // Runtime
+            plan_msg->param   = exec_data_r.second.param_p;                                          // Parameters
+            plan_msg->options = boost::optional<const boost_pt::ptree&>(                             // exec options
+                  task_data.run_list.at( exec_idx ).options );
 
-            plan_pt.put_child("dst",     exec_list_pt ); // Name of the exec block to update
-            plan_pt.put_child("common",  cres_list_pt ); // Common resources
-            plan_pt.put_child("options",                 // exec options
-                  exec_data_r.second.task_p.get().second.run_list.at( exec_idx ).options );
+            plan_msg->dst.push_back( exec_data_r.second.id );  // ID of the exec block to update
 
-            core_o->write( pt_out.set( plan_pt )); // Write data to the output
+            plan_msg->cres_list.resize( task_data.cres_id_list.size());
 
-            // Dump pt packets as they depart from the output of the block
-            dump_buf_core_o.write( plan_pt, BUF_WRITE_LAST );
+            for( std::size_t cres_idx = 0; cres_idx < task_data.cres_id_list.size(); cres_idx ++ ) {
+               plan_msg->cres_list.at( cres_idx ).id     = task_data.cres_id_list.at( cres_idx );
+               plan_msg->cres_list.at( cres_idx ).demand = task_data.run_list.at( exec_idx ).cres_demand.at( cres_idx );
+            }
 
+            plan_write( plan_msg ); // Write data to the output
          } // for( std::size_t exec_idx = 0; exec_idx < wait_el.mask_exec_size; exec_idx ++ )
          wait_el.thrd_p.get().second.seq_state  = SEQ_STATE_RUNNING;
-      } // BOOST_FOREACH( wait_list_t::value_type& wait_el, wait_list )
+      } // for( wait_list_t::iterator wait_it = wait_list.begin(); wait_it != wait_end; wait_it ++ )
+
+      // Dispatched threads leave the waiting list
+      wait_list.erase( wait_list.begin(), wait_end );
+   } // if( alloc_pend && !wait_list.empty() && exec_free.any())
+
+   alloc_pend = false;
+} // schd_planner_c::plan_update(
+
+void schd_planner_c::plan_complete(
+      const schd_msg_exec_plan_t& core_msg_inp ) {
+   // Dump pt packets as they arrive to the input of the block
+   schd_msg_dump( dump_buf_core_i, core_msg_inp );
+
+   // Resolve the execution block ID
+   if( core_msg_inp.src >= exec_id_vect.size() ||
+       !exec_id_vect.at( core_msg_inp.src ).is_initialized()) {
+      SCHD_REPORT_ERROR( "schd::plan" ) << name()
+                                        << " Can't resolve exec ID: "
+                                        << core_msg_inp.src;
+   }
 
-      wait_list.clear();
+   // Update exec statuses and thread sequences
+   boost::optional<exec_list_t::value_type&> exec_p = exec_id_vect.at( core_msg_inp.src );
+
+   // Casting to non-const to modify
+   boost::optional<thrd_list_t::value_type&> thrd_p =
+         boost::optional<thrd_list_t::value_type&>(
+               const_cast<thrd_list_t::value_type&>( exec_p.get().second.thrd_p.get()) );
+
+   // Free exec
+   exec_p.get().second.time_end = sc_core::sc_time_stamp();
+   exec_p.get().second.thrd_p.reset();
+   exec_p.get().second.task_p.reset();
+   exec_p.get().second.param_p.reset();
+
+   exec_free[exec_p.get().second.idx] = true;
+   alloc_pend = true;
+
+   // Update thread information
+   auto exec_list_it = std::find_if(
+         thrd_p.get().second.exec_list.begin(),
+         thrd_p.get().second.exec_list.end(),
+         [exec_p]( const boost::optional<const exec_list_t::value_type&> &el )->bool {
+            return el.get_ptr() == exec_p.get_ptr(); } );
+
+   if( exec_list_it == thrd_p.get().second.exec_list.end()) {
+      SCHD_REPORT_ERROR( "schd::plan" ) << name()
+                                        << " Can't find exec name: "
+                                        << exec_p.get().first
+                                        << " in the exec_list of the thread "
+                                        << thrd_p.get().first;
+   }
 
-      sc_core::wait( core_i->data_written_event());
+   thrd_p.get().second.exec_list.erase( exec_list_it );
 
-      while( core_i->num_available()) {
-         // Read from port
-         boost_pt::ptree        core_pt_raw = core_i->read().get();
-         const boost_pt::ptree& core_pt_inp = core_pt_raw;
+   while( thrd_p.get().second.exec_list.empty()) {
+      thrd_p.get().second.seq_idx ++;
 
-         // Dump pt packets as they arrive to the input of the block
-         dump_buf_core_i.write( core_pt_inp, BUF_WRITE_LAST );
+      if( thrd_p.get().second.seq_idx >= thrd_p.get().second.seq_list.size()) {
+         // End of thread. Release the events which are not used anymore
+         BOOST_FOREACH( const event_ref_t& evnt_ref, thrd_p.get().second.evnt_list ) {
+            event_get( evnt_ref ).thrd_end_cntr ++;
+            event_done.push_back( evnt_ref.slot );
+         }
 
-         // Update exec statuses and thread sequences
-         boost::optional<std::string>            src_p = core_pt_inp.get_optional<std::string>("src");        // Tread name
-         boost::optional<const boost_pt::ptree&> dst_p = core_pt_inp.get_child_optional("dst");          // task name
+         event_cleanup();
 
-         if( !src_p.is_initialized() ||
-             !dst_p.is_initialized()) {
-            std::string core_pt_str;
+         thrd_p.get().second.seq_state = SEQ_STATE_IDLE;
+         thrd_p.get().second.evnt_list.clear();
+         thrd_dirty[thrd_p.get().second.idx] = true; // Can be re-started by the events in the register
+         break;
+      }
+      else if( thrd_p.get().second.seq_list.at(
+            thrd_p.get().second.seq_idx ).task_p.is_initialized() ) {
+         // Proceed with the new task from the sequence
+         thrd_p.get().second.seq_state = SEQ_STATE_WAITING;
+         wait_list_add( thrd_p.get());
+         break;
+      }
+      else {
+         // Register new event
+         event_add( thrd_p.get().second.seq_list.at( thrd_p.get().second.seq_idx ).evnt_id );
+      }
+   } // while( thrd_p.get().second.exec_list.empty())
+} // schd_planner_c::plan_complete(
 
-            SCHD_REPORT_ERROR( "schd::plan" ) << name()
-                                              << " Incorrect data format from exec: "
-                                              << pt2str( core_pt_inp, core_pt_str );
-         }
+void schd_planner_c::plan_write(
+      const schd_msg_plan_exec_ptr& plan_msg ) {
+   if( plan_write_f ) {
+      plan_write_f( plan_msg ); // Native engine
+   }
+   else {
+      schd_sig_ptree_c pt_out;
+
+      core_o->write( pt_out.set( plan_msg )); // Write data to the output
+   }
 
-         // Resolve the execution block name
-         boost::optional<exec_list_t::value_type&> exec_p =
-               boost::optional<exec_list_t::value_type&>( *exec_list.find( src_p.get()) );
+   // Dump pt packets as they depart from the output of the block
+   schd_msg_dump( dump_buf_core_o, *plan_msg );
+} // schd_planner_c::plan_write(
 
-         if( exec_p.get_ptr() ==
-               boost::optional<exec_list_t::value_type&>( *exec_list.end()).get_ptr()) {
-            SCHD_REPORT_ERROR( "schd::plan" ) << name()
-                                              << " Can't resolve exec name: "
-                                              << exec_p.get().first;
-         }
+std::size_t schd_planner_c::event_add(
+      std::size_t name_id ) {
+   std::size_t slot;
 
-         // Casting to non-const to modify
-         boost::optional<thrd_list_t::value_type&> thrd_p =
-               boost::optional<thrd_list_t::value_type&>(
-                     const_cast<thrd_list_t::value_type&>( exec_p.get().second.thrd_p.get()) );
+   // Reuse a free slot or extend the register
+   if( !event_free.empty()) {
+      slot = event_free.back();
+      event_free.pop_back();
+   }
+   else {
+      slot = event_reg.size();
+      event_reg.push_back( event_data_t());
+   }
 
-         // Free exec
-         exec_p.get().second.time_end = sc_core::sc_time_stamp();
-         exec_p.get().second.thrd_p.reset();
-         exec_p.get().second.task_p.reset();
-         exec_p.get().second.param_p.reset();
+   event_data_t& event_data = event_reg.at( slot );
+
+   event_data.name_id = name_id;
+   event_data.thrd_caller.reset();
+   event_data.time    = sc_core::sc_time_stamp();
+   event_data.thrd_run_bits.reset();
+   event_data.thrd_run_bits.resize( thrd_list.size());
+   event_data.thrd_run_cntr = 0;
+   event_data.thrd_end_cntr = 0;
+   event_data.seq  = event_seq ++;
+   event_data.used = true;
+
+   event_bucket.at( name_id ).push_back( slot );
+   event_data.bucket_it = std::prev( event_bucket.at( name_id ).end());
+
+   // Threads which can be started by the new event
+   thrd_dirty |= evnt_thrd_bits.at( name_id );
+
+   // Checked at the next end of a thread
+   event_done.push_back( slot );
+
+   return slot;
+} // schd_planner_c::event_add(
+
+void schd_planner_c::event_cleanup(
+      void ) {
+   // Release rule is evaluated at the end of a thread. It depends only on the counters of the event,
+   // so only the events which were added or whose threads have finished since the previous check
+   // can change their state
+   BOOST_FOREACH( std::size_t slot, event_done ) {
+      event_data_t& event_data = event_reg.at( slot );
+
+      if( event_data.used &&                                         // Not released yet
+          event_data.thrd_end_cntr == event_data.thrd_run_cntr &&     // All the started threads have finished
+          2 * event_data.thrd_run_cntr + 1 >= thrd_list.size()) {
+         event_bucket.at( event_data.name_id ).erase( event_data.bucket_it );
+         event_data.used = false;
+         event_data.gen ++;
+         event_free.push_back( slot );
+      }
+   }
 
-         // Update thread information
-         auto exec_list_it = std::find_if(
-               thrd_p.get().second.exec_list.begin(),
-               thrd_p.get().second.exec_list.end(),
-               [exec_p]( const boost::optional<const exec_list_t::value_type&> &el )->bool {
-                  return el.get_ptr() == exec_p.get_ptr(); } );
+   event_done.clear();
+} // schd_planner_c::event_cleanup(
 
-         if( exec_list_it == thrd_p.get().second.exec_list.end()) {
-            SCHD_REPORT_ERROR( "schd::plan" ) << name()
-                                              << " Can't find exec name: "
-                                              << exec_p.get().first
-                                              << " in the exec_list of the thread "
-                                              << thrd_p.get().first;
-         }
+schd_planner_c::event_data_t& schd_planner_c::event_get(
+      const event_ref_t& ref ) {
+   event_data_t& event_data = event_reg.at( ref.slot );
 
-         thrd_p.get().second.exec_list.erase( exec_list_it );
+   if( !event_data.used || event_data.gen != ref.gen ) {
+      SCHD_REPORT_ERROR( "schd::plan" ) << name()
+                                        << " Stale reference to the event slot "
+                                        << ref.slot;
+   }
 
-         while( thrd_p.get().second.exec_list.empty()) {
-            thrd_p.get().second.seq_idx ++;
+   return event_data;
+} // schd_planner_c::event_get(
 
-            if( thrd_p.get().second.seq_idx >= thrd_p.get().second.seq_list.size()) {
-               // End of thread
-               BOOST_FOREACH( boost::optional<event_reg_t::value_type&> evnt_el,
-                     thrd_p.get().second.evnt_list ) {
-                  evnt_el.get().thrd_end_cntr ++;
-               }
+void schd_planner_c::wait_list_add(
+      thrd_list_t::value_type& thrd_el ) {
+   wait_data_t wait_data;
 
-               thrd_p.get().second.seq_state = SEQ_STATE_IDLE;
-               thrd_p.get().second.evnt_list.clear();
-               break;
-            }
-            else if( thrd_p.get().second.seq_list.at(
-                  thrd_p.get().second.seq_idx ).task_p.is_initialized() ) {
-               // Proceed with the new task from the sequence
-               thrd_p.get().second.seq_state = SEQ_STATE_WAITING;
-               break;
-            }
-            else {
-               // Register new event
-               event_data.name_p = boost::optional<const std::string&>(
-                     thrd_p.get().second.seq_list.at( thrd_p.get().second.seq_idx ).name );
-               event_data.time   = sc_core::sc_time_stamp();
-               event_reg.push_back( event_data );
-            }
-         } // while( thrd_p.get().second.exec_list.empty())
-
-         // Cleanup event register
-         if( thrd_p.get().second.seq_state == SEQ_STATE_IDLE ) {
-            BOOST_FOREACH( event_reg_t::value_type& evnt_el, event_reg ) {
-               if( evnt_el.thrd_end_cntr == evnt_el.thrd_run_list.size() &&
-                   evnt_el.thrd_end_cntr + evnt_el.thrd_run_list.size() + 1 >=
-                   thrd_list.size()) {
-                  evnt_el.remove = true;
-               }
-            }
+   wait_data.thrd_p   = boost::optional<      thrd_list_t::value_type&>( thrd_el );
+   wait_data.task_p   = boost::optional<const task_list_t::value_type&>(
+         thrd_el.second.seq_list.at( thrd_el.second.seq_idx ).task_p );
 
-            event_reg.remove_if( []( event_reg_t::value_type& el )->bool {
-               return el.remove; } );
-         } // if( thrd_p.get().second.seq_state == SEQ_STATE_IDLE )
+   if( !wait_data.task_p.is_initialized()) {
+      SCHD_REPORT_ERROR( "schd::plan" )
+            << name()
+            << " Incorrect sequence element "
+            << thrd_el.second.seq_list.at( thrd_el.second.seq_idx ).name
+            << " while processing thread "
+            << thrd_el.first;
+   }
 
-      } // while( core_i->num_available())
-   } // for(;;)
-} // schd_planner_c::exec_thrd(
+   // Sequence number keeps the order of arrival for the threads with equal priorities
+   wait_list.insert( wait_list_t::value_type(
+         wait_key_t( thrd_el.second.priority, wait_seq ++ ),
+         wait_data ));
+   alloc_pend = true;
+} // schd_planner_c::wait_list_add(
 
 bool schd_planner_c::and_list(
-      std::vector<boost::optional<const boost::regex&>>& msk, // regex masks
-      std::vector<boost::optional<const std::string&>>&  val, // check values
-      std::vector<std::size_t>& msk_val_map,                  // matching value for each mask
-      std::vector<std::size_t>& val_msk_cnt ) {               // Number of masks matching each value
-
-   // Create and fill the matrix of matches
-   std::vector<std::vector<std::size_t>> mat( msk.size(), std::vector<std::size_t>( val.size(), 0 ));
-   std::vector<std::size_t> mv_cnt( msk.size(), 0 );
-   std::vector<std::size_t> vm_cnt( val.size(), std::numeric_limits<std::size_t>::max() );
-   val_msk_cnt.assign( val.size(), 0 );
-   msk_val_map.assign( msk.size(), std::numeric_limits<std::size_t>::max() );
-
-   for( std::size_t msk_idx = 0; msk_idx < msk.size(); msk_idx ++ ) {
-      for( std::size_t val_idx = 0; val_idx < val.size(); val_idx ++ ) {
-         if( boost::regex_match( val.at( val_idx ).get(), msk.at(msk_idx ).get() )) {
-            mat.at( msk_idx ).at( val_idx ) = 1;
-            mv_cnt.at(  msk_idx ) ++;
-            vm_cnt.at(  val_idx ) =
-                  ( vm_cnt.at( val_idx ) > msk.size() ) ? 1
-                                                        : ( vm_cnt.at( val_idx ) + 1 );
-
-            // We need to fill this vector so we run till the end
-            val_msk_cnt.at( val_idx ) ++;
-         }
+      const std::vector<boost::dynamic_bitset<>>& mat, // match matrix: row for each mask, bit for each value
+      std::size_t val_size,                            // number of check values
+      std::vector<std::size_t>& msk_val_map,           // matching value for each mask
+      std::vector<std::size_t>& val_msk_cnt ) {        // Number of masks matching each value
+
+   val_msk_cnt.assign( val_size, 0 );
+   msk_val_map.assign( mat.size(), std::numeric_limits<std::size_t>::max() );
+
+   // Count the masks matching each value. We need to fill this vector so we run till the end
+   bool msk_none = false;
+
+   for( std::size_t msk_idx = 0; msk_idx < mat.size(); msk_idx ++ ) {
+      msk_none |= mat.at( msk_idx ).none();
+
+      for( std::size_t val_idx = mat.at( msk_idx ).find_first();
+                       val_idx < val_size;
+                       val_idx = mat.at( msk_idx ).find_next( val_idx )) {
+         val_msk_cnt.at( val_idx ) ++;
       }
    }
 
    // exit if we have at least 1 mask without a matching value
-   if( std::find( mv_cnt.begin(), mv_cnt.end(), 0 ) != mv_cnt.end() ) {
+   if( msk_none ) {
       return false;
    }
 
+   if( alloc_mode == ALLOC_MATCHING ) {
+      return and_list_match( mat, val_size, msk_val_map );
+   }
+
+   return and_list_greedy( mat, val_size, msk_val_map );
+} // and_list(
+
+bool schd_planner_c::and_list_greedy(
+      const std::vector<boost::dynamic_bitset<>>& mat, // match matrix: row for each mask, bit for each value
+      std::size_t val_size,                            // number of check values
+      std::vector<std::size_t>& msk_val_map ) {        // matching value for each mask
+
+   std::vector<std::size_t> mv_cnt( mat.size(), 0 );
+   std::vector<std::size_t> vm_cnt( val_size, std::numeric_limits<std::size_t>::max() );
+
+   for( std::size_t msk_idx = 0; msk_idx < mat.size(); msk_idx ++ ) {
+      for( std::size_t val_idx = mat.at( msk_idx ).find_first();
+                       val_idx < val_size;
+                       val_idx = mat.at( msk_idx ).find_next( val_idx )) {
+         mv_cnt.at(  msk_idx ) ++;
+         vm_cnt.at(  val_idx ) =
+               ( vm_cnt.at( val_idx ) > mat.size() ) ? 1
+                                                     : ( vm_cnt.at( val_idx ) + 1 );
+      }
+   }
+
    while( true ) {
       // Find mask with min number of matching values
       std::size_t min_mv_cnt_idx = std::distance( mv_cnt.begin(),
                                                   std::min_element( mv_cnt.begin(), mv_cnt.end()));
 
-      if( mv_cnt.at( min_mv_cnt_idx ) <= val.size() ) {
+      if( mv_cnt.at( min_mv_cnt_idx ) <= val_size ) {
          // Find value with min number of matching masks
          std::size_t min_vm_cnt_idx = std::numeric_limits<std::size_t>::max(),
                      min_vm_cnt_val = std::numeric_limits<std::size_t>::max();
 
-         for( std::size_t val_idx = 0; val_idx < val.size(); val_idx ++ ) {
-            if( mat.at( min_mv_cnt_idx ).at( val_idx ) &&
+         for( std::size_t val_idx = 0; val_idx < val_size; val_idx ++ ) {
+            if( mat.at( min_mv_cnt_idx )[val_idx] &&
                 min_vm_cnt_val > vm_cnt.at( val_idx )) {
                 min_vm_cnt_val = vm_cnt.at( val_idx );
                 min_vm_cnt_idx = val_idx;
@@ -740,16 +886,16 @@ bool schd_planner_c::and_list(
          mv_cnt.at( min_mv_cnt_idx ) = std::numeric_limits<std::size_t>::max();
          vm_cnt.at( min_vm_cnt_idx ) = std::numeric_limits<std::size_t>::max();
 
-         for( std::size_t msk_idx = 0; msk_idx < msk.size(); msk_idx ++ ) {
-            mv_cnt.at( msk_idx ) -= mat.at( msk_idx ).at( min_vm_cnt_idx );
+         for( std::size_t msk_idx = 0; msk_idx < mat.size(); msk_idx ++ ) {
+            mv_cnt.at( msk_idx ) -= mat.at( msk_idx )[min_vm_cnt_idx];
 
             if( mv_cnt.at( msk_idx ) == 0 ) {
                 mv_cnt.at( msk_idx ) = std::numeric_limits<std::size_t>::max();
             }
          }
 
-         for( std::size_t val_idx = 0; val_idx < val.size(); val_idx ++ ) {
-            vm_cnt.at( val_idx ) -= mat.at( min_mv_cnt_idx ).at( val_idx );
+         for( std::size_t val_idx = 0; val_idx < val_size; val_idx ++ ) {
+            vm_cnt.at( val_idx ) -= mat.at( min_mv_cnt_idx )[val_idx];
 
             if( vm_cnt.at( val_idx ) == 0 ) {
                 vm_cnt.at( val_idx ) = std::numeric_limits<std::size_t>::max();
@@ -766,6 +912,111 @@ bool schd_planner_c::and_list(
          msk_val_map.end(),
          std::numeric_limits<std::size_t>::max() );
 
-} // and_list(
+} // and_list_greedy(
+
+bool schd_planner_c::and_list_match(
+      const std::vector<boost::dynamic_bitset<>>& mat, // match matrix: row for each mask, bit for each value
+      std::size_t val_size,                            // number of check values
+      std::vector<std::size_t>& msk_val_map ) {        // matching value for each mask
+
+   // Hopcroft-Karp maximum bipartite matching between the masks and the values
+   const std::size_t nil = std::numeric_limits<std::size_t>::max();
+
+   std::vector<std::size_t> val_msk_map( val_size, nil );
+   std::vector<std::size_t> msk_dist( mat.size(), nil );
+   std::vector<std::size_t> msk_queue( mat.size());
+   std::size_t              msk_free = mat.size();
+
+   // Initial greedy matching
+   for( std::size_t msk_idx = 0; msk_idx < mat.size(); msk_idx ++ ) {
+      for( std::size_t val_idx = mat.at( msk_idx ).find_first();
+                       val_idx < val_size;
+                       val_idx = mat.at( msk_idx ).find_next( val_idx )) {
+         if( val_msk_map.at( val_idx ) == nil ) {
+            val_msk_map.at( val_idx ) = msk_idx;
+            msk_val_map.at( msk_idx ) = val_idx;
+            msk_free --;
+            break;
+         }
+      }
+   }
+
+   while( msk_free != 0 ) {
+      // BFS from the free masks. Build layers of the alternating paths
+      std::size_t queue_head = 0;
+      std::size_t queue_tail = 0;
+      bool        path_found = false;
+
+      for( std::size_t msk_idx = 0; msk_idx < mat.size(); msk_idx ++ ) {
+         if( msk_val_map.at( msk_idx ) == nil ) {
+            msk_dist.at( msk_idx ) = 0;
+            msk_queue.at( queue_tail ++ ) = msk_idx;
+         }
+         else {
+            msk_dist.at( msk_idx ) = nil;
+         }
+      }
+
+      while( queue_head != queue_tail ) {
+         std::size_t msk_idx = msk_queue.at( queue_head ++ );
+
+         for( std::size_t val_idx = mat.at( msk_idx ).find_first();
+                          val_idx < val_size;
+                          val_idx = mat.at( msk_idx ).find_next( val_idx )) {
+            std::size_t msk_next = val_msk_map.at( val_idx );
+
+            if( msk_next == nil ) {
+               path_found = true;
+            }
+            else if( msk_dist.at( msk_next ) == nil ) {
+               msk_dist.at( msk_next ) = msk_dist.at( msk_idx ) + 1;
+               msk_queue.at( queue_tail ++ ) = msk_next;
+            }
+         }
+      } // while( queue_head != queue_tail )
+
+      if( !path_found ) {
+         break; // Maximum matching is reached
+      }
+
+      // DFS along the layers. Augment the matching with the vertex-disjoint shortest paths
+      for( std::size_t msk_idx = 0; msk_idx < mat.size(); msk_idx ++ ) {
+         if( msk_val_map.at( msk_idx ) == nil &&
+             and_list_path( mat, msk_idx, msk_val_map, val_msk_map, msk_dist )) {
+            msk_free --;
+         }
+      }
+   } // while( msk_free != 0 )
+
+   return msk_free == 0;
+} // and_list_match(
+
+bool schd_planner_c::and_list_path(
+      const std::vector<boost::dynamic_bitset<>>& mat,
+      std::size_t msk_idx,
+      std::vector<std::size_t>& msk_val_map,
+      std::vector<std::size_t>& val_msk_map,
+      std::vector<std::size_t>& msk_dist ) {
+
+   const std::size_t nil = std::numeric_limits<std::size_t>::max();
+
+   for( std::size_t val_idx = mat.at( msk_idx ).find_first();
+                    val_idx < val_msk_map.size();
+                    val_idx = mat.at( msk_idx ).find_next( val_idx )) {
+      std::size_t msk_next = val_msk_map.at( val_idx );
+
+      if( msk_next == nil ||
+          ( msk_dist.at( msk_next ) == msk_dist.at( msk_idx ) + 1 &&
+            and_list_path( mat, msk_next, msk_val_map, val_msk_map, msk_dist ))) {
+         val_msk_map.at( val_idx ) = msk_idx;
+         msk_val_map.at( msk_idx ) = val_idx;
+         return true;
+      }
+   }
+
+   msk_dist.at( msk_idx ) = nil; // Dead end. Exclude from the further search in this phase
+
+   return false;
+} // and_list_path(
 
 } // namespace schd
@@ -0,0 +1,99 @@
+/*
+ * schd_ptree_disp.cpp
+ *
+ *  Description:
+ *    System component: ptree dispatch table
+ */
+
+#include <algorithm>
+#include <boost/foreach.hpp>
+#include "schd_ptree_disp.h"
+#include "schd_assert.h"
+#include "schd_report.h"
+
+namespace schd {
+
+schd_ptree_disp_c::schd_ptree_disp_c(
+      const char* nm )
+   : sc_core::sc_object( nm ) {
+
+}
+
+void schd_ptree_disp_c::add_dst(
+      schd_fifo_c<schd_sig_ptree_c>& dst ) {
+   dst_list.push_back( &dst );
+   dst_epoch.push_back( 0 );
+} // schd_ptree_disp_c::add_dst(
+
+const std::vector<std::size_t>& schd_ptree_disp_c::dst_check(
+      const schd_sig_ptree_c& sig ) {
+
+   if( dst_list.size() == 1 ) { // Single destination. Don't check dst
+      return dst_single;
+   }
+   else if( !sig.msg()) {
+      SCHD_REPORT_ERROR( "schd::disp" ) << name() << " Untyped message in the direct interconnect";
+   }
+
+   dst_epoch_cur ++;
+
+   BOOST_FOREACH( std::size_t dst_idx, sig.msg()->dst ) {
+      if( dst_idx >= dst_list.size()) {
+         SCHD_REPORT_ERROR( "schd::disp" ) << name() << " Destination not found: #" << dst_idx;
+      }
+      else if( dst_epoch.at( dst_idx ) == dst_epoch_cur ) {
+         SCHD_REPORT_ERROR( "schd::disp" ) << name() << " Duplicate access: #" << dst_idx;
+      }
+      else {
+         dst_epoch.at( dst_idx ) = dst_epoch_cur;
+      }
+   }
+
+   return sig.msg()->dst;
+} // schd_ptree_disp_c::dst_check(
+
+void schd_ptree_disp_c::write(
+      const schd_sig_ptree_c& sig ) {
+
+   BOOST_FOREACH( std::size_t dst_idx, dst_check( sig )) {
+      dst_list.at( dst_idx )->write( sig ); // Write data to the destination
+   }
+} // schd_ptree_disp_c::write(
+
+bool schd_ptree_disp_c::nb_write(
+      const schd_sig_ptree_c& sig ) {
+   const std::vector<std::size_t>& dst_idx_list = dst_check( sig );
+
+   // Message is written to all the destinations or to none of them
+   BOOST_FOREACH( std::size_t dst_idx, dst_idx_list ) {
+      if( dst_list.at( dst_idx )->num_free() == 0 ) {
+         return false;
+      }
+   }
+
+   BOOST_FOREACH( std::size_t dst_idx, dst_idx_list ) {
+      dst_list.at( dst_idx )->nb_write( sig );
+   }
+
+   return true;
+} // schd_ptree_disp_c::nb_write(
+
+int schd_ptree_disp_c::num_free(
+      void ) const {
+   int num_free_min = 0;
+
+   for( std::size_t dst_idx = 0; dst_idx < dst_list.size(); dst_idx ++ ) {
+      num_free_min = ( dst_idx == 0 ) ? dst_list.at( dst_idx )->num_free()
+                                      : std::min( num_free_min, dst_list.at( dst_idx )->num_free());
+   }
+
+   return num_free_min;
+} // schd_ptree_disp_c::num_free(
+
+const sc_core::sc_event& schd_ptree_disp_c::data_read_event(
+      void ) const {
+   // Producers of the core use the blocking write. Event of the first destination is sufficient
+   return dst_list.at( 0 )->data_read_event();
+} // schd_ptree_disp_c::data_read_event(
+
+} // namespace schd
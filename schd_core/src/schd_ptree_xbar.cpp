@@ -22,8 +22,8 @@ schd_ptree_xbar_c::schd_ptree_xbar_c(
    , vi( "vi" )
    , vo( "vo" ) {
 
-   // Process registrations
-   SC_THREAD( exec_thrd );
+   // Process registrations. Inputs are known after init(): the method is triggered dynamically
+   SC_METHOD( exec_meth );
 }
 
 void schd_ptree_xbar_c::init(
@@ -164,102 +164,153 @@ void schd_ptree_xbar_c::init(
 
       dst_map_it = std::next( dst_map_it );
    } // BOOST_FOREACH( const boost_pt::ptree::value_type& dst_el, dst_list_p.get())
+
+   // Resolve the names of the outputs. Output which is found first has the priority, same as in the linear search
+   BOOST_FOREACH( const port_map_t& dst_map, vo_map ) {
+      if( !dst_map.regex && dst_idx_map.find( dst_map.name ) == dst_idx_map.end()) {
+         dst_find( dst_map.name );
+      }
+   }
+
+   dst_epoch.resize( vo_map.size(), 0 );
 } // void schd_ptree_xbar_c::init(
 
-void schd_ptree_xbar_c::exec_thrd( void ) {
-   sc_core::wait(sc_core::SC_ZERO_TIME);
+std::size_t schd_ptree_xbar_c::dst_find(
+      const std::string& dst_name ) {
+   dst_idx_map_t::const_iterator dst_it = dst_idx_map.find( dst_name );
 
-   for(;;) {
-      // Create an event combined from all the input ports
-      sc_core::sc_event_or_list status_vi_or_list;
+   if( dst_it != dst_idx_map.end()) {
+      return dst_it->second;
+   }
 
-      for( std::size_t n_stat = 0; n_stat < vi.size(); n_stat ++ ) {
-         status_vi_or_list |= vi.at( n_stat )->data_written_event();
-      }
+   auto vo_map_it = std::find_if(
+       vo_map.begin(),
+       vo_map.end(),
+       [&dst_name]( const port_map_t &el )->bool {
+          return el.regex ? boost::regex_match( dst_name,   el.mask )
+                          :                   ( dst_name == el.name ); } );
+
+   if( vo_map_it == vo_map.end()) {
+      SCHD_REPORT_ERROR( "schd::xbar" ) << name() << " Destination not found: " << dst_name;
+   }
+
+   std::size_t dst_idx = std::distance(
+         vo_map.begin(), vo_map_it );
+
+   dst_idx_map.emplace( std::make_pair( dst_name, dst_idx ));
 
-      sc_core::wait( status_vi_or_list );
+   return dst_idx;
+} // schd_ptree_xbar_c::dst_find(
 
-      // Resolve events which were triggered, and make a list of event sources
+void schd_ptree_xbar_c::exec_meth( void ) {
+   if( vi.size() == 0 ) { // xbar is not initialized, e.g. unused by the direct interconnect
+      return;             // Not triggered again
+   }
+   else if( vi_or_list.size() == 0 ) {
+      // First activation. Ports are bound: create an event combined from all the input ports
       for( std::size_t n_stat = 0; n_stat < vi.size(); n_stat ++ ) {
-         while( vi.at( n_stat )->num_available()) {
-            boost_pt::ptree        pt_raw = vi.at( n_stat )->read().get();
-            const boost_pt::ptree& pt_inp = pt_raw;
-            schd_sig_ptree_c       pt_out;
+         vi_or_list |= vi.at( n_stat )->data_written_event();
+      }
 
-            if( vi_map.at( n_stat ).dump_p.is_initialized()) {
-               vi_map.at( n_stat ).dump_p.get().write( pt_inp, BUF_WRITE_LAST );
-            }
+      sc_core::next_trigger( vi_or_list );
+      return;
+   }
 
-            if( vo.size() == 1 ) { // Single output. Don't check dst
-               pt_out.set( pt_inp );
-               vo.at( 0 )->write( pt_out );
+   // Resolve events which were triggered, and make a list of event sources
+   for( std::size_t n_stat = 0; n_stat < vi.size(); n_stat ++ ) {
+      sig_inp_list.clear();
+      vi.at( n_stat )->read_all( sig_inp_list );
 
-               if( vo_map.at( 0 ).dump_p.is_initialized()) {
-                  vo_map.at( 0 ).dump_p.get().write( pt_inp, BUF_WRITE_LAST );
-               }
-            } // if( vo.size() == 1 )
-            else {
-               boost::optional<const boost_pt::ptree&> dst_list_p = pt_inp.get_child_optional("dst");
-               boost::optional<std::string>            dst_str_p  = pt_inp.get_optional<std::string>("dst");
+      BOOST_FOREACH( const schd_sig_ptree_c& sig_inp, sig_inp_list ) {
 
-               if( dst_str_p.is_initialized() && dst_str_p.get() == "broadcast") { // Broadcast to all outputs
-                  pt_out.set( pt_inp );
+         if( vi_map.at( n_stat ).dump_p.is_initialized()) {
+            vi_map.at( n_stat ).dump_p.get().write_lazy(
+                  [&sig_inp]()->const boost_pt::ptree& {
+                     return sig_inp.get(); },
+                  BUF_WRITE_LAST );
+         }
 
-                  for( std::size_t dst_idx = 0; dst_idx < vo.size(); dst_idx ++ ) {
-                     vo.at( dst_idx )->write( pt_out );
+         if( vo.size() == 1 ) { // Single output. Don't check dst
+            vo.at( 0 )->write( sig_inp );
 
-                     if( vo_map.at( dst_idx ).dump_p.is_initialized()) {
-                        vo_map.at( dst_idx ).dump_p.get().write( pt_inp, BUF_WRITE_LAST );
-                     }
+            if( vo_map.at( 0 ).dump_p.is_initialized()) {
+               vo_map.at( 0 ).dump_p.get().write_lazy(
+                     [&sig_inp]()->const boost_pt::ptree& {
+                        return sig_inp.get(); },
+                     BUF_WRITE_LAST );
+            }
+         } // if( vo.size() == 1 )
+         else if( sig_inp.msg()) {
+            // Typed message. Destination ID is the index of the output
+            dst_epoch_cur ++;
+
+            BOOST_FOREACH( std::size_t dst_idx, sig_inp.msg()->dst ) {
+               if( dst_idx >= vo.size()) {
+                  SCHD_REPORT_ERROR( "schd::xbar" ) << name() << " Destination not found: #" << dst_idx;
+               }
+               else if( dst_epoch.at( dst_idx ) == dst_epoch_cur ) {
+                  SCHD_REPORT_ERROR( "schd::xbar" ) << name() << " Duplicate access: #" << dst_idx;
+               }
+               else {
+                  vo.at( dst_idx )->write( sig_inp ); // Write data to the output
+                  dst_epoch.at( dst_idx ) = dst_epoch_cur;
+
+                  if( vo_map.at( dst_idx ).dump_p.is_initialized()) {
+                     vo_map.at( dst_idx ).dump_p.get().write_lazy(
+                           [&sig_inp]()->const boost_pt::ptree& {
+                              return sig_inp.get(); },
+                           BUF_WRITE_LAST );
                   }
-               } else if( dst_list_p.is_initialized()) {
-                  std::vector<bool> dst_wr( vo.size(), false );
+               }
+            } // BOOST_FOREACH( std::size_t dst_idx, sig_inp.msg()->dst )
+         } // if( vo.size() == 1 ) ... else if( sig_inp.msg())
+         else {
+            // Payload of the input is shared by all the outputs
+            const boost_pt::ptree& pt_inp = sig_inp.get();
 
-                  BOOST_FOREACH( const boost_pt::ptree::value_type& dst_el, dst_list_p.get()) {
-                     if( !dst_el.first.empty()) {
-                        SCHD_REPORT_ERROR( "schd::xbar" ) << name() <<  " Incorrect structure";
-                     }
+            boost::optional<const boost_pt::ptree&> dst_list_p = pt_inp.get_child_optional("dst");
+            boost::optional<std::string>            dst_str_p  = pt_inp.get_optional<std::string>("dst");
 
-                     boost::optional<std::string> dst_mod_p = dst_el.second.get_value_optional<std::string>();
+            if( dst_str_p.is_initialized() && dst_str_p.get() == "broadcast") { // Broadcast to all outputs
+               for( std::size_t dst_idx = 0; dst_idx < vo.size(); dst_idx ++ ) {
+                  vo.at( dst_idx )->write( sig_inp );
 
-                     if( !dst_mod_p.is_initialized()) {
-                        SCHD_REPORT_ERROR( "schd::xbar" ) << name() << " Incorrect format";
-                     }
+                  if( vo_map.at( dst_idx ).dump_p.is_initialized()) {
+                     vo_map.at( dst_idx ).dump_p.get().write( pt_inp, BUF_WRITE_LAST );
+                  }
+               }
+            } else if( dst_list_p.is_initialized()) {
+               dst_epoch_cur ++;
 
-                     auto vo_map_it = std::find_if(
-                         vo_map.begin(),
-                         vo_map.end(),
-                         [dst_mod_p]( const port_map_t &el )->bool {
-                            return el.regex ? boost::regex_match( dst_mod_p.get(),   el.mask )
-                                            :                   ( dst_mod_p.get() == el.name ); } );
+               BOOST_FOREACH( const boost_pt::ptree::value_type& dst_el, dst_list_p.get()) {
+                  if( !dst_el.first.empty()) {
+                     SCHD_REPORT_ERROR( "schd::xbar" ) << name() <<  " Incorrect structure";
+                  }
 
-                     if( vo_map_it == vo_map.end()) {
-                        SCHD_REPORT_ERROR( "schd::xbar" ) << name() << " Destination not found: " << dst_mod_p.get();
-                     }
+                  const std::string& dst_mod = dst_el.second.data();
+                  std::size_t        dst_idx = dst_find( dst_mod );
 
-                     std::size_t dst_idx = std::distance(
-                           vo_map.begin(), vo_map_it );
+                  if( dst_epoch.at( dst_idx ) == dst_epoch_cur ) {
+                     SCHD_REPORT_ERROR( "schd::xbar" ) << name() << " Duplicate access: " << dst_mod;
+                  }
+                  else {
+                     vo.at( dst_idx )->write( sig_inp ); // Write data to the output
+                     dst_epoch.at( dst_idx ) = dst_epoch_cur;
 
-                     if( dst_wr.at( dst_idx )) {
-                        SCHD_REPORT_ERROR( "schd::xbar" ) << name() << " Duplicate access: " << dst_mod_p.get();
+                     if( vo_map.at( dst_idx ).dump_p.is_initialized()) {
+                        vo_map.at( dst_idx ).dump_p.get().write( pt_inp, BUF_WRITE_LAST );
                      }
-                     else {
-                        vo.at( dst_idx )->write( pt_out.set( pt_inp )); // Write data to the output
-                        dst_wr.at( dst_idx ) = true;
+                  }
+               } // BOOST_FOREACH( const boost_pt::ptree::value_type& dst_el, dst_list_p.get())
+            } // if( dst_list_p.is_initialized())
+            else {
+               SCHD_REPORT_ERROR( "schd::xbar" ) << name() << " Destination not found";
+            }
+         } // if( vo.size() == 1 ) ... else if( sig_inp.msg()) ... else ...
+      } // BOOST_FOREACH( const schd_sig_ptree_c& sig_inp, sig_inp_list )
+   } // for( std::size_t n_stat = 0; n_stat < vi.size(); n_stat ++ )
 
-                        if( vo_map.at( dst_idx ).dump_p.is_initialized()) {
-                           vo_map.at( dst_idx ).dump_p.get().write( pt_inp, BUF_WRITE_LAST );
-                        }
-                     }
-                  } // BOOST_FOREACH( const boost_pt::ptree::value_type& dst_el, dst_list_p.get())
-               } // if( dst_list_p.is_initialized())
-               else {
-                  SCHD_REPORT_ERROR( "schd::xbar" ) << name() << " Destination not found";
-               }
-            } // if( vo.size() == 1 ) ... else ...
-         } // while( vi.at( n_stat )->num_available())
-      } // for( std::size_t n_stat = 0; n_stat < vi.size(); n_stat ++ )
-   } // for(;;)
-}
+   sc_core::next_trigger( vi_or_list );
+} // schd_ptree_xbar_c::exec_meth(
 
 } // namespace schd
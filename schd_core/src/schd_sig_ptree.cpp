@@ -19,15 +19,24 @@ namespace boost_jp = boost::property_tree::json_parser;
 
 namespace schd {
 
+// Trace registration is not copied
+schd_sig_ptree_c::schd_sig_ptree_c(
+      const schd_sig_ptree_c& rhs ) {
+   *this = rhs;
+}
+
+schd_sig_ptree_c::schd_sig_ptree_c(
+      schd_sig_ptree_c&& rhs ) {
+   *this = std::move( rhs );
+}
+
 // Signal assignment (property tree)
 schd_sig_ptree_c& schd_sig_ptree_c::set(
       const boost_pt::ptree& rhs ) {
-   data = rhs;
+   data_p = std::make_shared<const boost_pt::ptree>( rhs );
+   msg_p.reset();
 
-   data_hash = 0;
-   boost::hash_combine(
-         data_hash,
-         data );
+   hash_update();
 
    return *this;
 }
@@ -35,39 +44,137 @@ schd_sig_ptree_c& schd_sig_ptree_c::set(
 // Signal assignment (json string)
 schd_sig_ptree_c& schd_sig_ptree_c::set(
       const std::string& rhs ) {
-   str2pt( rhs, data );
+   std::shared_ptr<boost_pt::ptree> pt_p = std::make_shared<boost_pt::ptree>();
 
-   data_hash = 0;
-   boost::hash_combine(
-         data_hash,
-         data );
+   str2pt( rhs, *pt_p );
+
+   data_p = pt_p;
+   msg_p.reset();
+
+   hash_update();
+
+   return *this;
+}
+
+// Signal assignment (shared property tree)
+schd_sig_ptree_c& schd_sig_ptree_c::set(
+      const std::shared_ptr<const boost_pt::ptree>& rhs ) {
+   data_p = rhs;
+   msg_p.reset();
+
+   hash_update();
+
+   return *this;
+}
+
+// Signal assignment (typed message)
+schd_sig_ptree_c& schd_sig_ptree_c::set(
+      const schd_msg_ptr& rhs ) {
+   data_p.reset();
+   msg_p = rhs;
+
+   hash_update();
 
    return *this;
 }
 
 const boost_pt::ptree& schd_sig_ptree_c::get(
       void ) const {
-   return data;
+   static const boost_pt::ptree data_empty;
+
+   if( data_p ) {
+      return *data_p;
+   }
+   else if( msg_p ) {
+      // Create property tree from the typed message
+      std::shared_ptr<boost_pt::ptree> pt_p = std::make_shared<boost_pt::ptree>();
+
+      msg_p->to_ptree( *pt_p );
+      data_p = pt_p;
+
+      return *data_p;
+   }
+
+   return data_empty;
+}
+
+const schd_msg_ptr& schd_sig_ptree_c::msg(
+      void ) const {
+   return msg_p;
 }
 
 // Required by sc_signal<> and sc_fifo<>
+// Payload is shared. Neither the property tree nor the hash are recalculated
 schd_sig_ptree_c& schd_sig_ptree_c::operator = (
       const schd_sig_ptree_c& rhs ) {
-   data = rhs.data;
+   data_p = rhs.data_p;
+   msg_p  = rhs.msg_p;
 
-   data_hash = 0;
-   boost::hash_combine(
-         data_hash,
-         rhs.data );
+   if( rhs.hash_valid ) {
+      data_hash  = rhs.data_hash;
+      hash_valid = true;
+   }
+   else {
+      hash_update();
+   }
 
    return *this;
 }
 
+schd_sig_ptree_c& schd_sig_ptree_c::operator = (
+      schd_sig_ptree_c&& rhs ) {
+   data_p = std::move( rhs.data_p );
+   msg_p  = std::move( rhs.msg_p  );
+
+   if( rhs.hash_valid ) {
+      data_hash  = rhs.data_hash;
+      hash_valid = true;
+   }
+   else {
+      hash_update();
+   }
+
+   return *this;
+}
+
+std::size_t schd_sig_ptree_c::hash(
+      void ) const {
+   if( hash_valid ) {
+      return data_hash;
+   }
+   else if( msg_p ) {
+      return msg_p->hash();
+   }
+
+   std::size_t seed = 0;
+
+   boost::hash_combine(
+         seed,
+         get());
+
+   return seed;
+}
+
+void schd_sig_ptree_c::hash_update(
+      void ) {
+   hash_valid = false;
+
+   if( trace_en ) {
+      data_hash  = hash();
+      hash_valid = true;
+   }
+}
+
 // Required by sc_signal<>
 bool schd_sig_ptree_c::operator == (
       const schd_sig_ptree_c& rhs) const {
 
-   return ( data == rhs.data );
+   if(( msg_p  && msg_p  == rhs.msg_p  ) ||
+      ( data_p && data_p == rhs.data_p )) {
+      return true;
+   }
+
+   return ( get() == rhs.get());
 }
 
 std::ostream& operator << (
@@ -77,7 +184,7 @@ std::ostream& operator << (
    try {
       boost_jp::write_json(
             os,
-            sig.data );
+            sig.get());
    }
    catch( const boost_jp::json_parser_error& err ) {
       SCHD_REPORT_ERROR( "schd::ptree_sig" ) << err.what();
@@ -96,6 +203,12 @@ void sc_trace(
       const schd::schd_sig_ptree_c& sig,
       const std::string& name ) {
 
+   // Hash is kept up to date only for the traced signals
+   schd::schd_sig_ptree_c& sig_trace = const_cast<schd::schd_sig_ptree_c&>( sig );
+
+   sig.trace_en = true;
+   sig_trace.hash_update();
+
    // for property tree we trace only hash value to observe the changes
    sc_core::sc_trace(
          tf,
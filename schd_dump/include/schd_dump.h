@@ -11,14 +11,21 @@
 #include <vector>
 #include <string>
 #include <map>
+#include <memory>
+#include <iterator>
 #include <sstream>
 #include <iomanip>
+#include <mutex>
 #include <boost/property_tree/ptree.hpp>
+#include <boost/foreach.hpp>
 #include <boost/optional.hpp>
 #include <boost/regex.hpp>
 #include <systemc>
 #include <matio.h>
 #include "schd_dump_vec_wr.h"
+#include "schd_dump_writer.h"
+#include "schd_dump_backend.h"
+#include "schd_dump_close.h"
 #include "schd_report.h"
 
 // Short alias for the namespace
@@ -43,13 +50,119 @@ namespace schd {
 
    class  schd_dump_c; // Forward declaration to become a friend
 
+   // Dump buffer as it is seen by the dump register
+   class schd_dump_buf_if {
+   public:
+      virtual void flush(                 // Write the complete frames to the file. Frame in progress is dropped
+            void ) = 0;
+
+      virtual void flush_expired(         // Write the pending batch if the time window of its dump rule is over
+            void ) = 0;
+
+      virtual void resolve(               // Find the dump rules which match the buffer name
+            void ) = 0;
+
+      virtual ~schd_dump_buf_if() {}
+   }; // class schd_dump_buf_if
+
+   template <class T>
+   class schd_dump_frame_pool_c;
+
+   // Frame is written to the file. Frames are recycled together with their storage
+   template <class T>
+   class schd_dump_frame_job_c
+   : public schd_dump_job_c
+   , public schd_dump_frame_c {
+   public:
+      std::vector<T>                             data;
+      std::vector<std::string>                   data_conv; // Conversion scratch of data_mat()
+      schd_dump_backend_if*                      be_p = NULL;
+      std::shared_ptr<schd_dump_frame_pool_c<T>> pool_p;    // Set while the frame is in use
+
+      std::string exec(
+            void ) {
+         return be_p->frame_write( *this );
+      }
+
+      void done(
+            void ) {
+         // Capacity of the vectors is kept for the next frame
+         data.clear();
+         time.clear();
+
+         // Pool may be released with the last frame
+         std::shared_ptr<schd_dump_frame_pool_c<T>> pool_tmp_p;
+
+         pool_tmp_p.swap( pool_p );
+         pool_tmp_p->put( this );
+      }
+
+      matvar_t* data_mat(
+            void ) {
+         return vec_writer( data, data_conv );
+      }
+
+      void data_str(
+            std::vector<std::string>& str ) {
+         vec_str_writer( data, str );
+      }
+   }; // class schd_dump_frame_job_c
+
+   // Free frames of a dump buffer. Frames are returned by the writer threads
+   template <class T>
+   class schd_dump_frame_pool_c
+   : public std::enable_shared_from_this<schd_dump_frame_pool_c<T>> {
+   public:
+      ~schd_dump_frame_pool_c() {
+         BOOST_FOREACH( schd_dump_frame_job_c<T>* frame_p, free_list ) {
+            delete frame_p;
+         }
+      }
+
+      schd_dump_frame_job_c<T>* get(
+            void ) {
+         schd_dump_frame_job_c<T>* frame_p = NULL;
+
+         {
+            std::lock_guard<std::mutex> lock( mtx );
+
+            if( !free_list.empty()) {
+               frame_p = free_list.back();
+               free_list.pop_back();
+            }
+         }
+
+         if( frame_p == NULL ) {
+            frame_p = new schd_dump_frame_job_c<T>;
+         }
+
+         frame_p->pool_p = this->shared_from_this();
+
+         return frame_p;
+      }
+
+      void put(
+            schd_dump_frame_job_c<T>* frame_p ) {
+         std::lock_guard<std::mutex> lock( mtx );
+
+         free_list.push_back( frame_p );
+      }
+
+   private:
+      std::mutex                             mtx;
+      std::vector<schd_dump_frame_job_c<T>*> free_list;
+   }; // class schd_dump_frame_pool_c
+
    template <class T>
    class schd_dump_buf_c
-   : public sc_core::sc_attr_base {
+   : public sc_core::sc_attr_base
+   , public schd_dump_buf_if {
    public:
       schd_dump_buf_c(
             const std::string& name_ );
 
+      ~schd_dump_buf_c();
+
       // Write single element to the dump buffer
       schd_dump_buf_wret_t write(
             const T &elem,
@@ -60,6 +173,21 @@ namespace schd {
             const std::vector<T> &vec,
             schd_dump_buf_flag_t _flag = BUF_WRITE_CONT );
 
+      // Write single element which is produced by elem_f() only if the buffer records it
+      template <class F>
+      schd_dump_buf_wret_t write_lazy(
+            const F& elem_f,
+            schd_dump_buf_flag_t _flag = BUF_WRITE_CONT );
+
+      void flush(
+            void );
+
+      void flush_expired(
+            void );
+
+      void resolve(
+            void );
+
       friend class schd_dump_c;  // To access private members
 
    private:
@@ -70,27 +198,54 @@ namespace schd {
       std::size_t size_res = 0;           // Reserved size
       std::size_t size_max = 0;           // maximal  size
 
+      std::size_t      batch_size = 0;    // Batch is written when it has this many elements. 0 - no batching
+      sc_core::sc_time batch_time;        // ... or when it spans this time. SC_ZERO_TIME - no time limit
+      bool             batch_pend = false;// Buffer holds the complete frames which are not written yet
+      std::size_t      batch_end  = 0;    // Number of the elements in the complete frames
+      sc_core::sc_time batch_last;        // End time of the last complete frame
+
+      bool             frame_open = false;// Frame has been started and is not complete yet
+      sc_core::sc_time frame_str;         // Start time of the open frame
+
       sc_core::sc_time time_str;          // Start time of the current frame
       sc_core::sc_time time_end;          // End   time of the current frame
 
-      std::vector<T> buf;                 // main dump buffer
+      std::vector<T>      buf;            // main dump buffer
+      std::vector<double> buf_time;       // Time of each element. Used in the batches only
+
+      // Frames which are written to the file. Storage of the buffer is exchanged with a free frame
+      std::shared_ptr<schd_dump_frame_pool_c<T>> pool_p;
+
+      // Prepare the buffer for n elements. BUF_GENERAL_OK if the elements are to be recorded
+      schd_dump_buf_wret_t open(
+            std::size_t          n,
+            schd_dump_buf_flag_t _flag );
+
+      // Complete the update of the buffer. Write the frame or the batch if it is ready
+      schd_dump_buf_wret_t close(
+            std::size_t          n,
+            schd_dump_buf_flag_t _flag );
 
       int         reg_ref = reg_ref_free; // reference to the entry in the dump register
       std::size_t frame   = 0;            // dump frame counter for the unique variable name
       std::size_t name_hash;              // Name hash. This is used as a part of the variable name in the .mat file
 
+      std::vector<std::size_t> rule_list; // Entries of the dump register which match the name. Resolved once
+
    }; // class schd_dump_buf_c
 
    class schd_dump_c {
    public:
       void init(
-            boost::optional<const boost_pt::ptree&> _pref_p );
+            boost::optional<const boost_pt::ptree&> _pref_p,
+            boost::optional<const boost_pt::ptree&> _core_p );   // dump_threads, dump_queue
 
       void close_all(
             void );
 
       template <class T>
       friend class schd_dump_buf_c;
+      friend class schd_dump_close_c;
 
    private:
       typedef struct {
@@ -100,42 +255,90 @@ namespace schd {
          size_t           sr; // Reserved size
          size_t           sm; // Max size
          size_t           fr; // File reference
+         size_t           bs; // Batch size. 0 - no batching
+         sc_core::sc_time bt; // Batch time window
       } schd_dump_dreg_t;
 
-      typedef std::map<std::size_t, std::string> bi_t;
+      typedef schd_dump_index_t bi_t;
       typedef struct {
          sc_core::sc_time ts; // Start time
          sc_core::sc_time te; // End   time
          size_t           ns; // Number of active dump sources
          std::string      fn; // destination filename
-         mat_t           *fp; // matio file pointer
+         std::string      ff; // file format
          bi_t             bi; // source buffer index
+         bool             op; // File is open: frames have been written since the creation
+         std::shared_ptr<schd_dump_backend_if> be; // Format specific writer. Used by the writer only
       } schd_dump_freg_t;
 
+      // File is completed after all its frames
+      class close_job_c
+      : public schd_dump_job_c {
+      public:
+         schd_dump_backend_if* be_p;
+         bi_t                  bi;
+
+         std::string exec(
+               void ) {
+            return be_p->close( bi );
+         }
+      }; // class close_job_c
+
       std::vector<schd_dump_dreg_t> dump_reg; // dump register
       std::vector<schd_dump_freg_t> file_reg; // file register
 
+      std::vector<schd_dump_buf_if*> batch_list; // Buffers with the pending batches. Written out by close_all
+
+      // Buffers are resolved by init(). Buffers which are created later are resolved immediately
+      std::vector<schd_dump_buf_if*> buf_list;
+      bool                           init_done = false;
+
+      void buf_add(
+            schd_dump_buf_if* buf_p );
+
+      void buf_del(
+            schd_dump_buf_if* buf_p );
+
+      void rule_find(
+            const std::string&        buf_name,
+            std::vector<std::size_t>& rule_list );
+
+      void batch_add(
+            schd_dump_buf_if* buf_p );
+
+      void batch_del(
+            schd_dump_buf_if* buf_p );
+
       template <class T>
       int  check_dump(
             const schd_dump_buf_c<T> &buf );
 
       template <class T>
       void write_dump(
-            const schd_dump_buf_c<T> &buf );
+            schd_dump_buf_c<T> &buf );
 
-      // Housekeeping function which keeps track of the files which are not going to be used any longer
-      void housekeeping(
-            void );
+      // Frames are written by the background threads if dump_threads is set
+      schd_dump_writer_c writer;
+
+      void job_run(
+            std::size_t        fr,
+            schd_dump_job_ptr& job_p );
 
-      // Save hash-name index
-      void write_index(
-            const schd_dump_freg_t& file_data );
+      // Files which are closed after their end time. Ordered by the end time
+      std::vector<std::size_t>           close_list;
+      std::size_t                        close_idx = 0;
+      std::unique_ptr<schd_dump_close_c> close_p;
 
-      std::string hash_str(
-            std::size_t hash );
+      // Close the files which are over. Returns the time of the next check, SC_ZERO_TIME if there is none
+      sc_core::sc_time close_due(
+            void );
+
+      // Close the file if it is not going to be used any longer
+      void file_check(
+            schd_dump_freg_t& file_data );
 
-      static const enum mat_ft       MAT_FILE_VER    = MAT_FT_MAT5;           // _MAT5 - FAST; _MAT73 - SLOW
-      static const matio_compression MAT_COMPRESSION = MAT_COMPRESSION_ZLIB;  // Compression slightly slows down the dumping
+      void file_done(
+            schd_dump_freg_t& file_data );
    }; // class schd_dump_c
 
 extern schd::schd_dump_c   schd_dump;
@@ -143,18 +346,70 @@ extern schd::schd_dump_c   schd_dump;
 template <class T> schd_dump_buf_c<T>::schd_dump_buf_c(
       const std::string& name_ )
             : sc_core::sc_attr_base( name_ ) {
-   buf.resize( 0 );
-
    // Create hash for the supplied name
    name_hash = 0;
    boost::hash_combine(
          name_hash,
          name() );
+
+   schd_dump.buf_add( this );
 }
 
 template <class T> schd_dump_buf_wret_t schd_dump_buf_c<T>::write( // Write element to the buffer
             const T &elem,
             schd_dump_buf_flag_t _flag /*= BUF_WRITE_CONT*/ ) {
+   return write_lazy(
+         [&elem]()->const T& {
+            return elem; },
+         _flag );
+}
+
+template <class T> schd_dump_buf_c<T>::~schd_dump_buf_c() {
+   // Complete frames of the pending batch are not lost
+   if( batch_pend ) {
+      flush();
+   }
+
+   schd_dump.buf_del( this );
+}
+
+template <class T> template <class F> schd_dump_buf_wret_t schd_dump_buf_c<T>::write_lazy( // Write element to the buffer
+            const F& elem_f,
+            schd_dump_buf_flag_t _flag /*= BUF_WRITE_CONT*/ ) {
+   schd_dump_buf_wret_t ret = open( 1, _flag );
+
+   if( ret != schd_dump_buf_wret_t::BUF_GENERAL_OK ) {
+      return ret;
+   }
+
+   // Dump buffer update
+   buf.push_back( elem_f());
+
+   return close( 1, _flag );
+}
+
+template <class T> schd_dump_buf_wret_t schd_dump_buf_c<T>::write( // Write an array of elements to the buffer
+      const std::vector<T> &vec,
+      schd_dump_buf_flag_t _flag /*= BUF_WRITE_CONT*/ ) {
+   schd_dump_buf_wret_t ret = open( vec.size(), _flag );
+
+   if( ret != schd_dump_buf_wret_t::BUF_GENERAL_OK ) {
+      return ret;
+   }
+
+   // Dump buffer update
+   buf.insert(
+         buf.end(),
+         vec.begin(),
+         vec.end());
+
+   return close( vec.size(), _flag );
+}
+
+template <class T> schd_dump_buf_wret_t schd_dump_buf_c<T>::open(
+      std::size_t          n,
+      schd_dump_buf_flag_t _flag ) {
+
    // Check if the dump buffer update is skipped
    if( reg_ref == reg_ref_expr ) {
       return schd_dump_buf_wret_t::BUF_NO_OPERATION;
@@ -167,8 +422,18 @@ template <class T> schd_dump_buf_wret_t schd_dump_buf_c<T>::write( // Write elem
       return schd_dump_buf_wret_t::BUF_NO_OPERATION;
    }
 
+   // New frame. Pending batch is written before it overflows, when its time window is over
+   // or when the time window of the dump rule is over. Otherwise the frame is added to the batch
+   if( !frame_open && batch_pend ) {
+      if( buf.size() + n > size_max ||
+          ( batch_time != sc_core::SC_ZERO_TIME && sc_core::sc_time_stamp() - time_str >= batch_time ) ||
+          sc_core::sc_time_stamp() > schd_dump.dump_reg.at( reg_ref ).te ) {
+         flush();
+      }
+   }
+
    // First write to the dump buffer. Check if there is a valid reference in the register
-   if( buf.size() == 0 ) {
+   if( !frame_open && buf.size() == 0 ) {
       // Check if the buffer object is in the correct state
       if( reg_ref != reg_ref_free ) {
          SCHD_REPORT_ERROR( "schd::sys_dump" ) << name() << " Incorrect buffer state";
@@ -181,12 +446,17 @@ template <class T> schd_dump_buf_wret_t schd_dump_buf_c<T>::write( // Write elem
 
       if( reg_ref >= 0 ) {
          // Get buffer sizes
-         size_res = schd_dump.dump_reg.at( reg_ref ).sr;
-         size_max = schd_dump.dump_reg.at( reg_ref ).sm;
+         size_res   = schd_dump.dump_reg.at( reg_ref ).sr;
+         size_max   = schd_dump.dump_reg.at( reg_ref ).sm;
+         batch_size = schd_dump.dump_reg.at( reg_ref ).bs;
+         batch_time = schd_dump.dump_reg.at( reg_ref ).bt;
 
-         // Resize the buffer to the reserved size
-         buf.resize( size_res );
-         buf.clear();
+         // Reserve the storage. Recycled storage has the capacity already
+         buf.reserve( size_res );
+
+         if( batch_size != 0 || batch_time != sc_core::SC_ZERO_TIME ) {
+            buf_time.reserve( size_res );
+         }
       }
       else {
          if( reg_ref != reg_ref_expr ) {
@@ -197,18 +467,75 @@ template <class T> schd_dump_buf_wret_t schd_dump_buf_c<T>::write( // Write elem
       }
    }
 
+   // Open frame doesn't fit to the pending batch. Complete frames are written, the elements of the
+   // open frame are carried over to the new storage with the rule which the frame gets on its own
+   if( frame_open && batch_end != 0 && buf.size() + n > size_max ) {
+      std::vector<T>      frame_buf(
+            std::make_move_iterator( buf.begin() + batch_end ),
+            std::make_move_iterator( buf.end()));
+      std::vector<double> frame_time(
+            buf_time.begin() + batch_end,
+            buf_time.end());
+
+      buf.erase( buf.begin() + batch_end, buf.end());
+      buf_time.erase( buf_time.begin() + batch_end, buf_time.end());
+
+      // Rule is taken before the batch is written, so the file of the rule is kept open for the frame
+      sc_core::sc_time batch_str = time_str;
+
+      time_str = frame_str;
+
+      int frame_reg_ref = schd_dump.check_dump( *this );
+
+      time_str   = batch_str;
+      frame_open = false;
+
+      flush();
+
+      time_str = frame_str;
+
+      if( frame_reg_ref < 0 ) {
+         reg_ref = ( frame_reg_ref == reg_ref_expr ) ? reg_ref_expr : ( _flag ? reg_ref_free : reg_ref_skip );
+         return schd_dump_buf_wret_t::BUF_NO_OPERATION;
+      }
+
+      reg_ref = frame_reg_ref;
+
+      buf.insert(
+            buf.end(),
+            std::make_move_iterator( frame_buf.begin()),
+            std::make_move_iterator( frame_buf.end()));
+      buf_time.insert(
+            buf_time.end(),
+            frame_time.begin(),
+            frame_time.end());
+   }
+   else if( !frame_open ) {
+      frame_str = sc_core::sc_time_stamp();
+   }
+
+   frame_open = true;
+
    // Check for the overflow
-   if( buf.size() >= size_max ) {
+   if( buf.size() + n > size_max ) {
       SCHD_REPORT_ERROR( "schd::sys_dump" ) << name() << " Buffer overflow";
       return schd_dump_buf_wret_t::BUF_OVERFLOW;
    }
 
-   // Dump buffer update
-   buf.push_back( elem );
+   return schd_dump_buf_wret_t::BUF_GENERAL_OK;
+}
+
+template <class T> schd_dump_buf_wret_t schd_dump_buf_c<T>::close(
+      std::size_t          n,
+      schd_dump_buf_flag_t _flag ) {
 
    // Save simulation time of the last buffer update operation
    time_end = sc_core::sc_time_stamp();
 
+   if( batch_size != 0 || batch_time != sc_core::SC_ZERO_TIME ) {
+      buf_time.insert( buf_time.end(), n, time_end.to_double());
+   }
+
    schd_dump_buf_wret_t ret;
 
    if( buf.size() == size_max ) {
@@ -224,120 +551,88 @@ template <class T> schd_dump_buf_wret_t schd_dump_buf_c<T>::write( // Write elem
       ret = schd_dump_buf_wret_t::BUF_BELOW_MIN;
    }
 
-   // Last update to the buffer. Write dump to a file and clear buffer
+   // Last update to the frame. Write dump to a file or keep it for the batch.
+   // Batch is not kept after the time window of the dump rule
    if( _flag ) {
-      schd_dump.write_dump( *this );
-
-      // Set buffer size to zero while waiting for the next vector to start
-      buf.resize( 0 );
-
-      reg_ref = reg_ref_free; // Dump buffer is free
-      frame ++;               // Increment frame counter
+      frame_open = false;
+      batch_end  = buf.size();
+      batch_last = time_end;
+
+      if(( batch_size == 0 && batch_time == sc_core::SC_ZERO_TIME ) ||
+         ( batch_size != 0 && buf.size() >= batch_size ) ||
+         ( batch_time != sc_core::SC_ZERO_TIME && time_end - time_str >= batch_time ) ||
+         time_end > schd_dump.dump_reg.at( reg_ref ).te ) {
+         flush();
+      }
+      else if( !batch_pend ) {
+         batch_pend = true;
+         schd_dump.batch_add( this );
+      }
    }
 
    return ret;
 }
 
-template <class T> schd_dump_buf_wret_t schd_dump_buf_c<T>::write( // Write an array of elements to the buffer
-      const std::vector<T> &vec,
-      schd_dump_buf_flag_t _flag /*= BUF_WRITE_CONT*/ ) {
-
-   // Check if the dump buffer update is skipped
-   if( reg_ref == reg_ref_expr ) {
-      return schd_dump_buf_wret_t::BUF_NO_OPERATION;
-   }
-   else if( reg_ref == reg_ref_skip ) {
-      if( _flag ) {
-         reg_ref = reg_ref_free;
-      }
+// Write the frame or the batch of frames to the file
+template <class T> void schd_dump_buf_c<T>::flush(
+      void ) {
 
-      return schd_dump_buf_wret_t::BUF_NO_OPERATION;
+   if( batch_pend ) {
+      batch_pend = false;
+      schd_dump.batch_del( this );
    }
 
-   // First write to the dump buffer. Check if there is a valid reference in the register
-   if( buf.size() == 0 ) {
-      if( reg_ref != reg_ref_free ) {
-         // Check if the buffer object is in the correct state
-         SCHD_REPORT_ERROR( "schd::sys_dump" ) << name() << " Incorrect buffer state";
-         return schd_dump_buf_wret_t::BUF_GEN_ERROR;
-      }
-
-      time_str = sc_core::sc_time_stamp();
-
-      reg_ref = schd_dump.check_dump( *this );
+   // Frame in progress is dropped, same as the frame which is not complete at the end of the simulation
+   if( frame_open ) {
+      buf.erase( buf.begin() + batch_end, buf.end());
 
-      if( reg_ref >= 0 ) {
-         // Get buffer sizes
-         size_res = schd_dump.dump_reg.at( reg_ref ).sr;
-         size_max = schd_dump.dump_reg.at( reg_ref ).sm;
-
-         // Resize the buffer to the reserved size
-         buf.resize( size_res );
-         buf.clear();
+      if( buf_time.size() > batch_end ) {
+         buf_time.erase( buf_time.begin() + batch_end, buf_time.end());
       }
-      else {
-         if( reg_ref != reg_ref_expr ) {
-            reg_ref = _flag ? reg_ref_free : reg_ref_skip;
-         }
 
-         return schd_dump_buf_wret_t::BUF_NO_OPERATION;
-      }
+      time_end   = batch_last;
+      frame_open = false;
    }
 
-   // Check for the overflow
-   if( buf.size() + vec.size() > size_max ) {
-      SCHD_REPORT_ERROR( "schd::sys_dump" ) << name() << " Buffer overflow";
-      return schd_dump_buf_wret_t::BUF_OVERFLOW;
-   }
+   // Buffer gets the empty storage of a recycled frame
+   schd_dump.write_dump( *this );
 
-   // Dump buffer update
-   buf.insert(
-         buf.end(),
-         vec.begin(),
-         vec.end());
+   batch_end = 0;
 
-   // Save simulation time of the last buffer update operation
-   time_end = sc_core::sc_time_stamp();
+   reg_ref = reg_ref_free; // Dump buffer is free
+   frame ++;               // Increment frame counter
+}
 
-   schd_dump_buf_wret_t ret;
+// Pending batch is not kept after the time window of the dump rule
+template <class T> void schd_dump_buf_c<T>::flush_expired(
+      void ) {
 
-   if( buf.size() == size_max ) {
-      ret = schd_dump_buf_wret_t::BUF_FULL_MAX;
-   }
-   else if( buf.size() == size_max - 1 ) {
-      ret = schd_dump_buf_wret_t::BUF_PENULT_MAX;
-   }
-   else if( buf.size() > size_res ) {
-      ret = schd_dump_buf_wret_t::BUF_ABOVE_MIN;
-   }
-   else {
-      ret = schd_dump_buf_wret_t::BUF_BELOW_MIN;
+   if( batch_pend && !frame_open && sc_core::sc_time_stamp() > schd_dump.dump_reg.at( reg_ref ).te ) {
+      flush();
    }
+}
 
-   // Last update to the buffer. Write dump to a file and clear buffer
-   if( _flag ) {
-      schd_dump.write_dump( *this );
+// Find the dump rules of the buffer
+template <class T> void schd_dump_buf_c<T>::resolve(
+      void ) {
 
-      // Set buffer size to zero while waiting for the next vector to start
-      buf.resize( 0 );
+   schd_dump.rule_find( name(), rule_list );
 
-      reg_ref = reg_ref_free; // Dump buffer is now free
-      frame ++;               // Increment frame counter
+   // Buffer without the rules is never recorded
+   if( rule_list.empty()) {
+      reg_ref = reg_ref_expr;
    }
-
-   return ret;
 }
 
-// Check if the buffer is going to be dumped
+// Check if the buffer is going to be dumped. Only the rules which match the buffer name are checked
 template <class T> int  schd_dump_c::check_dump(
       const schd_dump_buf_c<T> &buf ) {
 
    int  dump_reg_ref = buf.reg_ref_skip;
    bool buf_to_be_used = false;
 
-   for( int dump_idx = 0; dump_idx < dump_reg.size(); dump_idx ++ ) {
-      bool buf_match = ( buf.time_str <= dump_reg.at( dump_idx ).te ) &&
-                         boost::regex_match( buf.name(), dump_reg.at( dump_idx ).re );
+   BOOST_FOREACH( std::size_t dump_idx, buf.rule_list ) {
+      bool buf_match = ( buf.time_str <= dump_reg.at( dump_idx ).te );
 
       buf_to_be_used |= buf_match;
 
@@ -353,177 +648,34 @@ template <class T> int  schd_dump_c::check_dump(
       }
    }
 
-   // Run housekeeping for the file register
-   housekeeping();
-
    return ( buf_to_be_used ? dump_reg_ref : buf.reg_ref_expr );
 } // template <class T> int schd_dump_c::check_dump(
 
-// Create dump variable and write dump buffer to file
+// Exchange the dump buffer with a free frame and write the frame to the file
 template <class T> void schd_dump_c::write_dump(
-      const schd_dump_buf_c<T> &buf ) {
-
-   // Create mat structure
-   const unsigned matstr_nfields = 5;
-   const char    *matstr_fields[matstr_nfields] = {
-        "name",         // Full name
-        "frame",        // Frame counter
-        "time_start",   // Frame start (simulation time)
-        "time_end",     // Frame end   (simulation time)
-        "data" };       // Data
-   const int     matstr_rank = 2;
-         size_t  matstr_dims[matstr_rank] = {1, 1};
-
-   // Variable name
-   std::stringstream os; // Convert frame counter
-   os << std::setfill('0')
-      << std::setw( sizeof( buf.frame ) * 2 )
-      << std::hex
-      << buf.frame;
-
-   std::string matstr_name = "v" + hash_str( buf.name_hash ) + "_f" + os.str();
-
-   matvar_t *matstr_p = Mat_VarCreateStruct(
-         matstr_name.c_str(),
-         matstr_rank,
-         matstr_dims,
-         matstr_fields,
-         matstr_nfields );
-
-   if( matstr_p == NULL ) {
-      SCHD_REPORT_ERROR( "schd::sys_dump" ) << " struct for " << buf.name();
-   }
-
-   matvar_t *field_p;
-   const int field_rank = 2;
-   size_t    field_dims[field_rank] = {1, 1};
-
-   // Update start time
-   double time_start = buf.time_str.to_double();
-   field_p = Mat_VarCreate(
-         NULL,
-         MAT_C_DOUBLE,
-         MAT_T_DOUBLE,
-         field_rank,
-         field_dims,
-         (void *)&time_start,
-         MAT_F_DONT_COPY_DATA );
-
-   if( field_p == NULL ) {
-      SCHD_REPORT_ERROR( "schd::sys_dump" ) << " struct field for " << buf.name();
-   }
-
-   Mat_VarSetStructFieldByName(
-         matstr_p,
-         "time_start",
-         0,
-         field_p );
-
-   // Update end time
-   double time_end = buf.time_end.to_double();
-   field_p = Mat_VarCreate(
-         NULL,
-         MAT_C_DOUBLE,
-         MAT_T_DOUBLE,
-         field_rank,
-         field_dims,
-         (void *)&time_end,
-         MAT_F_DONT_COPY_DATA );
-
-   if( field_p == NULL ) {
-      SCHD_REPORT_ERROR( "schd::sys_dump" ) << " struct field for " << buf.name();
-   }
+      schd_dump_buf_c<T> &buf ) {
 
-   Mat_VarSetStructFieldByName(
-         matstr_p,
-         "time_end",
-         0,
-         field_p );
-
-   // Update frame count
-   uint64_t frame = (double)buf.frame;
-   field_p = Mat_VarCreate(
-         NULL,
-         MAT_C_UINT64,
-         MAT_T_UINT64,
-         field_rank,
-         field_dims,
-         (void *)&frame,
-         MAT_F_DONT_COPY_DATA );
-
-   if( field_p == NULL ) {
-      SCHD_REPORT_ERROR( "schd::sys_dump" ) << " struct field for " << buf.name();
-   }
-
-   Mat_VarSetStructFieldByName(
-         matstr_p,
-         "frame",
-         0,
-         field_p );
-
-   // Call data writer
-   field_p = vec_writer( buf.buf );
-
-   if( field_p == NULL ) {
-      SCHD_REPORT_ERROR( "schd::sys_dump" ) << " struct field for " << buf.name();
-   }
-
-   Mat_VarSetStructFieldByName(
-         matstr_p,
-         "data",
-         0,
-         field_p );
-
-   // Update name
-   field_dims[0] = 1;
-   field_dims[1] = buf.name().size();
-
-   field_p = Mat_VarCreate(
-         NULL,
-         MAT_C_CHAR,
-         MAT_T_UTF8,
-         field_rank,
-         field_dims,
-         (void *)buf.name().c_str(),
-         MAT_F_DONT_COPY_DATA );
-
-   if( field_p == NULL ) {
-      SCHD_REPORT_ERROR( "schd::sys_dump" ) << " struct field for " << buf.name();
-   }
-
-   Mat_VarSetStructFieldByName(
-         matstr_p,
-         "name",
-         0,
-         field_p );
-
-   // File IO
    size_t file_reg_ref = dump_reg.at( buf.reg_ref ).fr;
 
-   // Check if the file needs to be created
-   if( file_reg.at( file_reg_ref ).fp == NULL ) {
-      file_reg.at( file_reg_ref ).fp = Mat_CreateVer(
-            file_reg.at( file_reg_ref ).fn.c_str(),
-            NULL,
-            MAT_FILE_VER );
-
-      if( file_reg.at( file_reg_ref ).fp == NULL ) {
-         SCHD_REPORT_ERROR( "schd::sys_dump" ) << " File I/O error for " << buf.name();
-      }
+   if( !buf.pool_p ) {
+      buf.pool_p = std::make_shared<schd_dump_frame_pool_c<T>>();
    }
 
-   // Write structure to a file
-   int res = Mat_VarWrite(
-         file_reg.at( file_reg_ref ).fp,
-         matstr_p,
-         MAT_COMPRESSION );
+   schd_dump_frame_job_c<T>* frame_p = buf.pool_p->get();
+   schd_dump_job_ptr         job_p( frame_p );
 
-   if( res != 0 ) {
-      SCHD_REPORT_ERROR( "schd::sys_dump" ) << " File I/O error for " << buf.name() << " ret:" << res;
-   }
+   frame_p->be_p       = file_reg.at( file_reg_ref ).be.get();
+   frame_p->name       = buf.name();
+   frame_p->name_hash  = buf.name_hash;
+   frame_p->frame      = buf.frame;
+   frame_p->time_start = buf.time_str.to_double();
+   frame_p->time_end   = buf.time_end.to_double();
+   frame_p->time.swap( buf.buf_time );
+   frame_p->data.swap( buf.buf );
+
+   file_reg.at( file_reg_ref ).op = true;
 
-   // Free memory
-   Mat_VarFree( matstr_p );
+   job_run( file_reg_ref, job_p );
 
    // Update buffer index
    auto bi_it = file_reg.at( file_reg_ref ).bi.find( buf.name_hash );
@@ -535,11 +687,10 @@ template <class T> void schd_dump_c::write_dump(
       SCHD_REPORT_ERROR( "schd::sys_dump" ) << " hash collision for " << buf.name();
    }
 
-   // Decrement source counter for the file
+   // Decrement source counter for the file. Last frame after the end time closes the file
    file_reg.at( file_reg_ref ).ns --;
 
-   // Run housekeeping for the file register
-   housekeeping();
+   file_check( file_reg.at( file_reg_ref ));
 
 } // template <class T> int schd_dump_c::write_dump(
 
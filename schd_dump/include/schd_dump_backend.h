@@ -0,0 +1,68 @@
+/*
+ * schd_dump_backend.h
+ *
+ *  Description:
+ *    Interface of the dump file formats
+ */
+
+#ifndef SCHD_DUMP_INCLUDE_SCHD_DUMP_BACKEND_H_
+#define SCHD_DUMP_INCLUDE_SCHD_DUMP_BACKEND_H_
+
+#include <map>
+#include <string>
+#include <vector>
+#include <sstream>
+#include <iomanip>
+#include <matio.h>
+
+namespace schd {
+
+   typedef std::map<std::size_t, std::string> schd_dump_index_t;  // Buffer name by the name hash
+
+   // Frame of a dump buffer. Data are moved from the buffer
+   class schd_dump_frame_c {
+   public:
+      virtual ~schd_dump_frame_c() {}
+
+      std::string         name;
+      std::size_t         name_hash  = 0;
+      std::size_t         frame      = 0;
+      double              time_start = 0.0;
+      double              time_end   = 0.0;
+      std::vector<double> time;             // Time of each element. Empty if the frame is not a batch
+
+      virtual matvar_t* data_mat(           // Data as a single MAT variable
+            void ) = 0;
+
+      virtual void data_str(                // Data as one string per element
+            std::vector<std::string>& str ) = 0;
+   }; // class schd_dump_frame_c
+
+   // Dump file format. Methods are executed by the writer and return error message, empty if OK
+   class schd_dump_backend_if {
+   public:
+      virtual ~schd_dump_backend_if() {}
+
+      virtual std::string frame_write(
+            schd_dump_frame_c& frame ) = 0;
+
+      // Complete the file. Next frame starts a new file
+      virtual std::string close(
+            const schd_dump_index_t& bi ) = 0;
+   }; // class schd_dump_backend_if
+
+   // Convert hash value into a string
+   inline std::string schd_dump_hash_str(
+         std::size_t hash ) {
+
+      std::stringstream os;
+      os << std::setfill('0')
+         << std::setw( sizeof( hash ) * 2 )
+         << std::hex
+         << hash;
+
+      return os.str();
+   }
+} // namespace schd
+
+#endif /* SCHD_DUMP_INCLUDE_SCHD_DUMP_BACKEND_H_ */
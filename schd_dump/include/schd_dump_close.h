@@ -0,0 +1,28 @@
+/*
+ * schd_dump_close.h
+ *
+ *  Description:
+ *    Declaration of the dump file closer: the files are closed after their end time
+ */
+
+#ifndef SCHD_DUMP_INCLUDE_SCHD_DUMP_CLOSE_H_
+#define SCHD_DUMP_INCLUDE_SCHD_DUMP_CLOSE_H_
+
+#include <systemc>
+
+namespace schd {
+
+   SC_MODULE( schd_dump_close_c ) { // declare module class
+
+   public:
+      // Constructor declaration
+      SC_CTOR( schd_dump_close_c );
+
+   private:
+      // Process declarations. The method is triggered at the next end time of the dump files
+      void exec_meth(
+            void );
+   }; // SC_MODULE( schd_dump_close_c )
+} // namespace schd
+
+#endif /* SCHD_DUMP_INCLUDE_SCHD_DUMP_CLOSE_H_ */
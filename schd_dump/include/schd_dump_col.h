@@ -0,0 +1,68 @@
+/*
+ * schd_dump_col.h
+ *
+ *  Description:
+ *    Columnar dump file format. Append-only file per dump buffer: <file>_<hash>.col,
+ *    and the text index <file> with the hash, name and column file of each buffer
+ */
+
+#ifndef SCHD_DUMP_INCLUDE_SCHD_DUMP_COL_H_
+#define SCHD_DUMP_INCLUDE_SCHD_DUMP_COL_H_
+
+#include <cstdio>
+#include <map>
+#include <string>
+#include <vector>
+#include "schd_dump_backend.h"
+#include "schd_dump_col_fmt.h"
+
+namespace schd {
+
+   class schd_dump_col_c
+   : public schd_dump_backend_if {
+   public:
+      typedef col::codec_t codec_t;
+
+      static const codec_t CODEC_NONE = col::CODEC_NONE;
+      static const codec_t CODEC_ZLIB = col::CODEC_ZLIB;
+
+      schd_dump_col_c(
+            const std::string& fn_,
+            codec_t            codec_ );
+
+      ~schd_dump_col_c();
+
+      std::string frame_write(
+            schd_dump_frame_c& frame );
+
+      std::string close(
+            const schd_dump_index_t& bi );
+
+   private:
+      typedef struct {
+         std::FILE*                fp     = NULL;
+         std::string               fn;            // Column file name
+         std::string               name;          // Buffer name
+         std::uint64_t             offset = 0;    // End of the file
+         std::uint64_t             rows   = 0;
+         std::vector<col::block_t> block_list;    // Footer index
+      } col_file_t;
+
+      std::string fn;                             // Index file name. Prefix of the column files
+      codec_t     codec;
+
+      typedef std::map<std::size_t, col_file_t> file_list_t;
+      file_list_t file_list;                      // Column files by the name hash
+
+      std::vector<char> block_raw;                // Scratch buffers
+      std::vector<char> block_zip;
+      std::vector<std::string> block_str;
+
+      std::string write(
+            col_file_t& file,
+            const void* data,
+            std::size_t size );
+   }; // class schd_dump_col_c
+} // namespace schd
+
+#endif /* SCHD_DUMP_INCLUDE_SCHD_DUMP_COL_H_ */
@@ -0,0 +1,67 @@
+/*
+ * schd_dump_col_fmt.h
+ *
+ *  Description:
+ *    Layout of the columnar dump file. One file per dump buffer, native byte order:
+ *
+ *    head_t
+ *    block 0 .. block N-1          Each block is a frame, padded to 8 bytes. Uncompressed block:
+ *                                    double        time  [rows]
+ *                                    std::uint64_t frame [rows]
+ *                                    std::uint64_t offset[rows + 1]   Element i is heap[offset[i], offset[i+1])
+ *                                    char          heap  [offset[rows]]
+ *    block_t [N]                   Footer index
+ *    name                          Full name of the buffer, padded to 8 bytes
+ *    tail_t
+ */
+
+#ifndef SCHD_DUMP_INCLUDE_SCHD_DUMP_COL_FMT_H_
+#define SCHD_DUMP_INCLUDE_SCHD_DUMP_COL_FMT_H_
+
+#include <cstdint>
+
+namespace schd {
+namespace col {
+
+   static const char          MAGIC_HEAD[8] = { 'S', 'C', 'H', 'D', 'C', 'O', 'L', '1' };
+   static const char          MAGIC_TAIL[8] = { 'S', 'C', 'H', 'D', 'E', 'N', 'D', '1' };
+   static const std::uint32_t VERSION       = 1;
+
+   typedef enum : std::uint32_t {
+      CODEC_NONE = 0,   // Block is stored as is
+      CODEC_ZLIB = 1,   // Block is deflated with zlib
+   } codec_t;
+
+   typedef struct {
+      char          magic[8];
+      std::uint32_t version;
+      std::uint32_t codec;       // Codec which was requested for the file
+   } head_t;
+
+   typedef struct {
+      std::uint64_t offset;      // Position in the file
+      std::uint64_t size;        // Stored size
+      std::uint64_t size_raw;    // Uncompressed size
+      std::uint64_t rows;        // Number of the elements
+      std::uint64_t row_first;   // Index of the first element in the file
+      std::uint64_t frame;       // Frame counter of the buffer
+      double        time_start;  // Frame start (simulation time)
+      double        time_end;    // Frame end   (simulation time)
+      std::uint32_t codec;       // Codec of the block. Blocks which don't compress are stored as is
+      std::uint32_t reserved;
+   } block_t;
+
+   typedef struct {
+      std::uint64_t block_offset; // Position of the footer index
+      std::uint64_t block_cnt;
+      std::uint64_t row_cnt;
+      std::uint64_t name_offset;
+      std::uint64_t name_size;
+      std::uint64_t name_hash;
+      char          magic[8];
+   } tail_t;
+
+} // namespace col
+} // namespace schd
+
+#endif /* SCHD_DUMP_INCLUDE_SCHD_DUMP_COL_FMT_H_ */
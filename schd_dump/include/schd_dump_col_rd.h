@@ -0,0 +1,100 @@
+/*
+ * schd_dump_col_rd.h
+ *
+ *  Description:
+ *    Reader of the columnar dump file. The file is memory mapped. Columns of the uncompressed
+ *    blocks are accessed in place, compressed blocks are inflated on demand.
+ *    Reader is used offline and doesn't depend on SystemC: errors throw std::runtime_error,
+ *    the row index out of range throws std::out_of_range. File is closed if open() fails
+ */
+
+#ifndef SCHD_DUMP_INCLUDE_SCHD_DUMP_COL_RD_H_
+#define SCHD_DUMP_INCLUDE_SCHD_DUMP_COL_RD_H_
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "schd_dump_col_fmt.h"
+
+namespace schd {
+
+   class schd_dump_col_rd_c {
+   public:
+      typedef struct {
+         double        time;   // Simulation time of the element
+         std::uint64_t frame;  // Frame counter
+         const char*   data;   // Element. Valid until a row from another compressed block is read
+         std::size_t   size;
+      } row_t;
+
+      ~schd_dump_col_rd_c();
+
+      void open(
+            const std::string& fn );
+
+      void close(
+            void );
+
+      const std::string& name(
+            void ) const {
+         return buf_name;
+      }
+
+      std::uint64_t name_hash(
+            void ) const {
+         return tail_p->name_hash;
+      }
+
+      std::size_t rows(
+            void ) const {
+         return tail_p->row_cnt;
+      }
+
+      std::size_t blocks(
+            void ) const {
+         return tail_p->block_cnt;
+      }
+
+      const col::block_t& block(
+            std::size_t block_idx ) const {
+         return block_p[block_idx];
+      }
+
+      row_t row(
+            std::size_t row_idx );
+
+      // First row with the time not less than the given time. rows() if there is none
+      std::size_t lower_bound(
+            double time );
+
+   private:
+      std::string          fn;
+      std::string          buf_name;
+      int                  fd        = -1;
+      const char*          map_p     = NULL;
+      std::size_t          map_size  = 0;
+
+      const col::tail_t*   tail_p    = NULL;
+      const col::block_t*  block_p   = NULL;
+
+      std::size_t          cache_idx = 0;      // Inflated block
+      bool                 cache_en  = false;
+      std::vector<std::uint64_t> cache;        // 8-byte aligned storage of the inflated block
+
+      void open_error(                         // Close the file and throw
+            const std::string& msg );
+
+      // Uncompressed content of the block
+      const char* block_data(
+            std::size_t block_idx );
+
+      void block_check(                        // Columns and heap fit to the uncompressed size
+            std::size_t block_idx,
+            const char* data_p ) const;
+
+      std::size_t block_find(                  // Block with the row
+            std::size_t row_idx ) const;
+   }; // class schd_dump_col_rd_c
+} // namespace schd
+
+#endif /* SCHD_DUMP_INCLUDE_SCHD_DUMP_COL_RD_H_ */
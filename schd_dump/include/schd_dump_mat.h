@@ -0,0 +1,44 @@
+/*
+ * schd_dump_mat.h
+ *
+ *  Description:
+ *    MAT5 dump file format. Each frame is a struct variable in the file
+ */
+
+#ifndef SCHD_DUMP_INCLUDE_SCHD_DUMP_MAT_H_
+#define SCHD_DUMP_INCLUDE_SCHD_DUMP_MAT_H_
+
+#include <string>
+#include <matio.h>
+#include "schd_dump_backend.h"
+
+namespace schd {
+
+   class schd_dump_mat_c
+   : public schd_dump_backend_if {
+   public:
+      schd_dump_mat_c(
+            const std::string& fn_ );
+
+      ~schd_dump_mat_c();
+
+      std::string frame_write(
+            schd_dump_frame_c& job );
+
+      std::string close(
+            const schd_dump_index_t& bi );
+
+   private:
+      std::string fn;          // destination filename
+      mat_t      *fp = NULL;   // matio file pointer
+
+      // Save hash-name index
+      std::string write_index(
+            const schd_dump_index_t& bi );
+
+      static const enum mat_ft       MAT_FILE_VER    = MAT_FT_MAT5;           // _MAT5 - FAST; _MAT73 - SLOW
+      static const matio_compression MAT_COMPRESSION = MAT_COMPRESSION_ZLIB;  // Compression slightly slows down the dumping
+   }; // class schd_dump_mat_c
+} // namespace schd
+
+#endif /* SCHD_DUMP_INCLUDE_SCHD_DUMP_MAT_H_ */
@@ -0,0 +1,76 @@
+/*
+ * schd_dump_queue.h
+ *
+ *  Description:
+ *    Bounded lock-free queue between the simulation and a dump writer thread.
+ *    Single producer, single consumer
+ */
+
+#ifndef SCHD_DUMP_INCLUDE_SCHD_DUMP_QUEUE_H_
+#define SCHD_DUMP_INCLUDE_SCHD_DUMP_QUEUE_H_
+
+#include <atomic>
+#include <utility>
+#include <vector>
+
+namespace schd {
+
+   template <class T>
+   class schd_dump_queue_c {
+   public:
+      schd_dump_queue_c(
+            std::size_t size_ ) {
+         // Size is rounded up to a power of two
+         std::size_t size = 1;
+
+         while( size < size_ ) {
+            size <<= 1;
+         }
+
+         buf.resize( size );
+         mask = size - 1;
+      }
+
+      // Element is moved only if there is a free slot
+      bool push(
+            T& elem ) {
+         std::size_t tail_cur = tail.load( std::memory_order_relaxed );
+
+         if( tail_cur - head.load( std::memory_order_acquire ) > mask ) {
+            return false; // Full
+         }
+
+         buf[tail_cur & mask] = std::move( elem );
+         tail.store( tail_cur + 1, std::memory_order_release );
+
+         return true;
+      }
+
+      bool pop(
+            T& elem ) {
+         std::size_t head_cur = head.load( std::memory_order_relaxed );
+
+         if( head_cur == tail.load( std::memory_order_acquire )) {
+            return false; // Empty
+         }
+
+         elem = std::move( buf[head_cur & mask] );
+         head.store( head_cur + 1, std::memory_order_release );
+
+         return true;
+      }
+
+      bool empty(
+            void ) const {
+         return head.load( std::memory_order_acquire ) == tail.load( std::memory_order_acquire );
+      }
+
+   private:
+      std::vector<T>           buf;
+      std::size_t              mask = 0;
+      std::atomic<std::size_t> head{ 0 };  // Next element to pop.  Updated by the consumer
+      std::atomic<std::size_t> tail{ 0 };  // Next element to push. Updated by the producer
+   }; // class schd_dump_queue_c
+} // namespace schd
+
+#endif /* SCHD_DUMP_INCLUDE_SCHD_DUMP_QUEUE_H_ */
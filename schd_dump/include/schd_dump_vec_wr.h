@@ -7,6 +7,8 @@
 #include <vector>
 #include <string>
 #include <complex>
+#include <sstream>
+#include <limits>
 #include <boost/property_tree/ptree.hpp>
 #include <boost/property_tree/json_parser.hpp>
 #include <matio.h>
@@ -39,10 +41,50 @@ matvar_t *vec_writer(
       const std::vector<std::string> &vec,
       const bool _copy = false );
 
-// Vector writers for schd core types
+// Vector writers for schd core types. Conversion errors throw std::runtime_error: the writers
+// are executed by the background threads which must not use the report
 matvar_t *vec_writer(
       const std::vector<boost_pt::ptree> &vec );
 
+// Vector writers with the conversion scratch of the caller. The scratch keeps its storage between the calls
+template <class T>
+matvar_t *vec_writer(
+      const std::vector<T> &vec,
+      std::vector<std::string> &vec_conv ) {
+
+   return vec_writer( vec );
+}
+
+matvar_t *vec_writer(
+      const std::vector<boost_pt::ptree> &vec,
+      std::vector<std::string> &vec_conv );
+
+// String writers. One string per element. Conversion errors throw std::runtime_error
+template <class T>
+void vec_str_writer(
+      const std::vector<T> &vec,
+      std::vector<std::string> &str ) {
+
+   str.clear();
+   str.reserve( vec.size());
+
+   for( typename std::vector<T>::const_iterator vec_it = vec.begin(); vec_it != vec.end(); vec_it ++ ) {
+      std::ostringstream os;
+
+      os.precision( std::numeric_limits<double>::max_digits10 );
+      os << *vec_it;
+
+      str.push_back( os.str());
+   }
+}
+
+void vec_str_writer(
+      const std::vector<std::string> &vec,
+      std::vector<std::string> &str );
+void vec_str_writer(
+      const std::vector<boost_pt::ptree> &vec,
+      std::vector<std::string> &str );
+
 } // namespace schd
 
 #endif /* SCHD_DUMP_INCLUDE_SCHD_DUMP_VEC_WR_H_ */
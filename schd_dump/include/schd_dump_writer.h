@@ -0,0 +1,94 @@
+/*
+ * schd_dump_writer.h
+ *
+ *  Description:
+ *    Background threads which serialize the dump frames and write them to the files
+ */
+
+#ifndef SCHD_DUMP_INCLUDE_SCHD_DUMP_WRITER_H_
+#define SCHD_DUMP_INCLUDE_SCHD_DUMP_WRITER_H_
+
+#include <atomic>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include "schd_dump_queue.h"
+
+namespace schd {
+
+   // Unit of work for the writer. Owns all the data it needs
+   class schd_dump_job_c {
+   public:
+      virtual ~schd_dump_job_c() {}
+
+      virtual std::string exec(   // Returns error message. Empty if OK
+            void ) = 0;
+
+      virtual void done(          // Job is released. Recycled jobs go back to their pool
+            void ) {
+         delete this;
+      }
+   }; // class schd_dump_job_c
+
+   typedef struct {
+      void operator()(
+            schd_dump_job_c* job_p ) const {
+         job_p->done();
+      }
+   } schd_dump_job_del_t;
+
+   typedef std::unique_ptr<schd_dump_job_c, schd_dump_job_del_t> schd_dump_job_ptr;
+
+   class schd_dump_writer_c {
+   public:
+      ~schd_dump_writer_c();
+
+      void init(
+            std::size_t thrd_num,       // Number of the writer threads. 0 - jobs are executed by the caller
+            std::size_t queue_size );   // Size of the queue of each thread
+
+      bool enabled(
+            void ) const {
+         return !worker_list.empty();
+      }
+
+      // Jobs with the same key are executed by the same thread in the order of the submission.
+      // Blocks while the queue is full
+      void push(
+            std::size_t        key,
+            schd_dump_job_ptr& job_p );
+
+      // Wait until all the jobs are done and stop the threads
+      void join(
+            void );
+
+   private:
+      typedef struct worker_s {
+         worker_s(
+               std::size_t queue_size )
+            : queue( queue_size ) {}
+
+         schd_dump_queue_c<schd_dump_job_ptr> queue;
+         std::thread                          thrd;
+         std::mutex                           mtx;        // Used only to sleep while the queue is empty
+         std::condition_variable              cv;
+      } worker_t;
+
+      std::vector<std::unique_ptr<worker_t>> worker_list;
+      std::atomic<bool>                      stop{ false };
+
+      std::mutex  err_mtx;
+      std::string err_str;   // First error in the threads. Reported by the simulation thread
+
+      void run(
+            worker_t& worker );
+
+      void error_check(
+            void );
+   }; // class schd_dump_writer_c
+} // namespace schd
+
+#endif /* SCHD_DUMP_INCLUDE_SCHD_DUMP_WRITER_H_ */
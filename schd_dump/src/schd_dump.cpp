@@ -5,9 +5,13 @@
  *    Methods for dump file io
  */
 
+#include <algorithm>
+#include <exception>
 #include <boost/foreach.hpp>
 #include <boost/regex.hpp>
 #include "schd_dump.h"
+#include "schd_dump_mat.h"
+#include "schd_dump_col.h"
 #include "schd_ptree_time.h"
 #include "schd_common.h" // Simulation end time
 #include "schd_report.h"
@@ -15,13 +19,34 @@
 namespace schd {
 
 void schd_dump_c::init(
-      boost::optional<const boost_pt::ptree&> _pref_p ) {
+      boost::optional<const boost_pt::ptree&> _pref_p,
+      boost::optional<const boost_pt::ptree&> _core_p ) {
 
    const boost_pt::ptree& pref = _pref_p.get();
 
+   // Background writer
+   if( _core_p.is_initialized()) {
+      boost::optional<int> thrd_num_p   = _core_p.get().get_optional<int>("dump_threads");
+      boost::optional<int> queue_size_p = _core_p.get().get_optional<int>("dump_queue");
+
+      if( thrd_num_p.is_initialized() && thrd_num_p.get() < 0 ) {
+         SCHD_REPORT_ERROR( "schd::sys_dump" ) << " Incorrect dump_threads: " << thrd_num_p.get();
+      }
+
+      if( queue_size_p.is_initialized() && queue_size_p.get() <= 0 ) {
+         SCHD_REPORT_ERROR( "schd::sys_dump" ) << " Incorrect dump_queue: " << queue_size_p.get();
+      }
+
+      writer.init(
+            thrd_num_p.is_initialized()   ? thrd_num_p.get()   : 0,
+            queue_size_p.is_initialized() ? queue_size_p.get() : 64 );
+   }
+
    BOOST_FOREACH( const boost_pt::ptree::value_type& dmp, pref ) {
       schd_dump_dreg_t dump_data;
       std::string      file_name;
+      std::string      file_format;
+      std::string      file_compression;
       std::string      str_time_str;
       std::string      end_time_str;
 
@@ -37,6 +62,14 @@ void schd_dump_c::init(
          dump_data.sr = dmp.second.get<size_t>("size_res");
          dump_data.sm = dmp.second.get<size_t>("size_max");
          file_name    = dmp.second.get<std::string>("file");
+
+         // File format and the compression of the columnar format
+         file_format      = dmp.second.get<std::string>("format",      "mat");
+         file_compression = dmp.second.get<std::string>("compression", "none");
+
+         // Frames are written in batches
+         dump_data.bs = dmp.second.get<size_t>("batch_size", 0);
+         dump_data.bt = dmp.second.get<sc_core::sc_time>("batch_time", sc_core::SC_ZERO_TIME);
       }
       catch( const boost_pt::ptree_error& err ) {
          SCHD_REPORT_ERROR( "schd::sys_dump" ) << err.what();
@@ -52,6 +85,10 @@ void schd_dump_c::init(
          SCHD_REPORT_ERROR( "schd::sys_dump" ) << " Incorrect specification of the buffer size";
       }
 
+      if( dump_data.bs > dump_data.sm ) {
+         SCHD_REPORT_ERROR( "schd::sys_dump" ) << " Incorrect specification of the batch size";
+      }
+
       // Convert end time
       dump_data.te = sc_core::sc_time::from_string(
             ( end_time_str == "finish" ) ? schd::schd_time.end_str.c_str()    // Dump until simulation finishes
@@ -66,6 +103,10 @@ void schd_dump_c::init(
       }
 
       if( fc != file_reg.size()) {
+         if( file_reg.at( fc ).ff != file_format ) {
+            SCHD_REPORT_ERROR( "schd::sys_dump" ) << " Inconsistent format for " << file_name;
+         }
+
          file_reg.at( fc ).ns ++;
          file_reg.at( fc ).ts = ( file_reg.at( fc ).ts > dump_data.ts ) ? dump_data.ts : file_reg.at( fc ).ts; // min
          file_reg.at( fc ).te = ( file_reg.at( fc ).te < dump_data.te ) ? dump_data.te : file_reg.at( fc ).te; // max
@@ -74,10 +115,31 @@ void schd_dump_c::init(
          schd_dump_freg_t file_data;
 
          file_data.fn = file_name;
-         file_data.fp = NULL;
+         file_data.ff = file_format;
+         file_data.op = false;
          file_data.ns = 0;
          file_data.ts = dump_data.ts;
          file_data.te = dump_data.te;
+
+         if( file_format == "mat" ) {
+            file_data.be = std::make_shared<schd_dump_mat_c>( file_name );
+         }
+         else if( file_format == "col" ) {
+            schd_dump_col_c::codec_t codec = schd_dump_col_c::CODEC_NONE;
+
+            if( file_compression == "zlib" ) {
+               codec = schd_dump_col_c::CODEC_ZLIB;
+            }
+            else if( file_compression != "none" ) {
+               SCHD_REPORT_ERROR( "schd::sys_dump" ) << " Unsupported compression: " << file_compression;
+            }
+
+            file_data.be = std::make_shared<schd_dump_col_c>( file_name, codec );
+         }
+         else {
+            SCHD_REPORT_ERROR( "schd::sys_dump" ) << " Unsupported format: " << file_format;
+         }
+
          file_reg.push_back( file_data );
       }
 
@@ -85,183 +147,171 @@ void schd_dump_c::init(
 
       dump_reg.push_back( dump_data );
    }
+
+   // Buffer names are constant. Rules of the existing buffers are resolved once
+   init_done = true;
+
+   BOOST_FOREACH( schd_dump_buf_if* buf_p, buf_list ) {
+      buf_p->resolve();
+   }
+
+   // Files are closed after their end time
+   for( std::size_t fc = 0; fc < file_reg.size(); fc ++ ) {
+      if( file_reg.at( fc ).te != sc_core::SC_ZERO_TIME ) {
+         close_list.push_back( fc );
+      }
+   }
+
+   std::sort(
+         close_list.begin(),
+         close_list.end(),
+         [this]( std::size_t fc_a, std::size_t fc_b )->bool {
+            return file_reg.at( fc_a ).te < file_reg.at( fc_b ).te; } );
+
+   if( !close_list.empty()) {
+      close_p.reset( new schd_dump_close_c( "schd_dump_close" ));
+   }
 } // void schd_dump_c::init(
 
 // Ensure that all files are closed
 void schd_dump_c::close_all(
       void ) {
+   // Write the pending batches. Buffers remove themselves from the list
+   while( !batch_list.empty()) {
+      batch_list.front()->flush();
+   }
+
    BOOST_FOREACH( schd_dump_freg_t& file_data, file_reg ) {
-      if( file_data.fp != NULL ) {
+      if( file_data.op ) {
+         file_done( file_data );
+      }
+   }
 
-         write_index( file_data );
+   // Wait for the background writer
+   if( writer.enabled()) {
+      writer.join();
+   }
+} // void schd_dump_c::close_all(
 
-         int res = Mat_Close(
-               file_data.fp );
+void schd_dump_c::batch_add(
+      schd_dump_buf_if* buf_p ) {
+   batch_list.push_back( buf_p );
+} // void schd_dump_c::batch_add(
+
+void schd_dump_c::batch_del(
+      schd_dump_buf_if* buf_p ) {
+   batch_list.erase( std::find(
+         batch_list.begin(),
+         batch_list.end(),
+         buf_p ));
+} // void schd_dump_c::batch_del(
+
+void schd_dump_c::buf_add(
+      schd_dump_buf_if* buf_p ) {
+   buf_list.push_back( buf_p );
+
+   if( init_done ) {
+      buf_p->resolve();
+   }
+} // void schd_dump_c::buf_add(
 
-         if( res != 0 ) {
-            SCHD_REPORT_ERROR( "schd::sys_dump" ) << " file close " << file_data.fn;
-         }
+void schd_dump_c::buf_del(
+      schd_dump_buf_if* buf_p ) {
+   buf_list.erase( std::find(
+         buf_list.begin(),
+         buf_list.end(),
+         buf_p ));
+} // void schd_dump_c::buf_del(
 
-         file_data.fp = NULL;
+void schd_dump_c::rule_find(
+      const std::string&        buf_name,
+      std::vector<std::size_t>& rule_list ) {
+
+   rule_list.clear();
+
+   for( std::size_t dump_idx = 0; dump_idx < dump_reg.size(); dump_idx ++ ) {
+      if( boost::regex_match( buf_name, dump_reg.at( dump_idx ).re )) {
+         rule_list.push_back( dump_idx );
       }
    }
-} // void schd_dump_c::close_all(
+} // void schd_dump_c::rule_find(
 
-// Look through the file register and close the files which are not going to be written any more
-void schd_dump_c::housekeeping(
+// Files are checked in the order of the end time. The file is closed at the first time point after
+// the end time: frames which start at the end time are still written to the file
+sc_core::sc_time schd_dump_c::close_due(
       void ) {
-   BOOST_FOREACH( schd_dump_freg_t& file_data, file_reg ) {
-      if( file_data.fp != NULL &&
-          file_data.ns == 0    &&
-          file_data.te <= sc_core::sc_time_stamp() &&
-          file_data.te != sc_core::SC_ZERO_TIME ) {
 
-         write_index( file_data );
-
-         int res = Mat_Close(
-               file_data.fp );
-
-         if( res != 0 ) {
-            SCHD_REPORT_ERROR( "schd::sys_dump" ) << " file close " << file_data.fn;
-         }
+   // Pending batches keep their files open. Buffers remove themselves from the list
+   std::vector<schd_dump_buf_if*> batch_due( batch_list );
 
-         file_data.fp = NULL;
-      }
+   BOOST_FOREACH( schd_dump_buf_if* buf_p, batch_due ) {
+      buf_p->flush_expired();
    }
-} // void schd_dump_c::housekeeping(
 
-// Save hash-name index to mat file
-void schd_dump_c::write_index(
-      const schd_dump_freg_t& file_data ) {
+   while( close_idx < close_list.size()) {
+      schd_dump_freg_t& file_data = file_reg.at( close_list.at( close_idx ));
 
-   // Create mat structure
-   const unsigned matstr_nfields = 3;
-   const char    *matstr_fields[matstr_nfields] = {
-        "hash",         // name hash
-        "hash_str",     // name hash (string representation)
-        "name" };       // full name
+      if( file_data.te >= sc_core::sc_time_stamp()) {
+         return file_data.te + sc_core::sc_get_time_resolution();
+      }
 
-   const int     matstr_rank = 2;
-         size_t  matstr_dims[matstr_rank] = {file_data.bi.size(), 1};
+      // Files with the open frames are closed by their last frame
+      file_check( file_data );
 
-   if( file_data.bi.size() == 0 ) {
-      return;
+      close_idx ++;
    }
 
-   matvar_t *matstr_p = Mat_VarCreateStruct(
-         "index",
-         matstr_rank,
-         matstr_dims,
-         matstr_fields,
-         matstr_nfields );
+   return sc_core::SC_ZERO_TIME;
+} // sc_core::sc_time schd_dump_c::close_due(
 
-   if( matstr_p == NULL ) {
-      SCHD_REPORT_ERROR( "schd::sys_dump" ) << " struct for index";
+void schd_dump_c::file_check(
+      schd_dump_freg_t& file_data ) {
+   if( file_data.op      &&
+       file_data.ns == 0 &&
+       file_data.te <  sc_core::sc_time_stamp() &&
+       file_data.te != sc_core::SC_ZERO_TIME ) {
+
+      file_done( file_data );
    }
+} // void schd_dump_c::file_check(
 
-   std::size_t bi_idx = 0;
-
-   BOOST_FOREACH( const bi_t::value_type &be, file_data.bi ) {
-      matvar_t *field_p;
-      const int field_rank = 2;
-      size_t    field_dims[field_rank];
-
-      // Save hash
-      uint64_t name_hash = be.first;
-      field_dims[0] = 1;
-      field_dims[1] = 1;
-      field_p = Mat_VarCreate(
-            NULL,
-            MAT_C_UINT64,
-            MAT_T_UINT64,
-            field_rank,
-            field_dims,
-            (void *)&name_hash,
-            0 );
-
-      if( field_p == NULL ) {
-         SCHD_REPORT_ERROR( "schd::sys_dump" ) << " struct field for index";
-      }
+// Write the index and close the file after the frames which are already submitted
+void schd_dump_c::file_done(
+      schd_dump_freg_t& file_data ) {
 
-      Mat_VarSetStructFieldByName(
-            matstr_p,
-            "hash",
-            bi_idx,
-            field_p );
-
-      // Save hash string
-      std::string name_hash_str = hash_str( be.first );
-      field_dims[0] = 1;
-      field_dims[1] = name_hash_str.size();
-      field_p = Mat_VarCreate(
-            NULL,
-            MAT_C_CHAR,
-            MAT_T_UTF8,
-            field_rank,
-            field_dims,
-            (void *)name_hash_str.c_str(),
-            0 );
-
-      if( field_p == NULL ) {
-         SCHD_REPORT_ERROR( "schd::sys_dump" ) << " struct field for index";
-      }
+   close_job_c*      close_p = new close_job_c;
+   schd_dump_job_ptr job_p( close_p );
 
-      Mat_VarSetStructFieldByName(
-            matstr_p,
-            "hash_str",
-            bi_idx,
-            field_p );
-
-      // Save name
-      field_dims[0] = 1;
-      field_dims[1] = be.second.size();
-      field_p = Mat_VarCreate(
-            NULL,
-            MAT_C_CHAR,
-            MAT_T_UTF8,
-            field_rank,
-            field_dims,
-            (void *)be.second.c_str(),
-            MAT_F_DONT_COPY_DATA );
-
-      if( field_p == NULL ) {
-         SCHD_REPORT_ERROR( "schd::sys_dump" ) << " struct field for index";
-      }
+   close_p->be_p = file_data.be.get();
+   close_p->bi   = file_data.bi;
 
-      Mat_VarSetStructFieldByName(
-            matstr_p,
-            "name",
-            bi_idx,
-            field_p );
+   file_data.op = false;
 
-      bi_idx ++;
-   }
+   job_run( &file_data - file_reg.data(), job_p );
+} // void schd_dump_c::file_done(
 
-   // Write structure to a file
-   int res = Mat_VarWrite(
-         file_data.fp,
-         matstr_p,
-         MAT_COMPRESSION );
+// Execute the job in the background writer or immediately
+void schd_dump_c::job_run(
+      std::size_t        fr,
+      schd_dump_job_ptr& job_p ) {
 
-   if( res != 0 ) {
-      SCHD_REPORT_ERROR( "schd::sys_dump" ) << " File I/O error for index";
+   if( writer.enabled()) {
+      writer.push( fr, job_p ); // All jobs of a file are executed by the same thread
    }
+   else {
+      std::string err;
 
-   // Free memory
-   Mat_VarFree( matstr_p );
-}
-
-// Convert hash value into a string
-std::string schd_dump_c::hash_str(
-      std::size_t hash ) {
-
-   std::stringstream os;
-   os << std::setfill('0')
-      << std::setw( sizeof( hash ) * 2 )
-      << std::hex
-      << hash;
+      try {
+         err = job_p->exec();
+      }
+      catch( const std::exception& err_ex ) {
+         err = err_ex.what();
+      }
 
-   return os.str();
-}
+      if( !err.empty()) {
+         SCHD_REPORT_ERROR( "schd::sys_dump" ) << err;
+      }
+   }
+} // void schd_dump_c::job_run(
 
 } // namespace schd
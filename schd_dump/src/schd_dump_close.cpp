@@ -0,0 +1,32 @@
+/*
+ * schd_dump_close.cpp
+ *
+ *  Description:
+ *    Dump file closer
+ */
+
+#include "schd_dump_close.h"
+#include "schd_dump.h"
+
+namespace schd {
+
+SC_HAS_PROCESS( schd::schd_dump_close_c );
+schd_dump_close_c::schd_dump_close_c(
+      sc_core::sc_module_name nm )
+   : sc_core::sc_module( nm ) {
+
+   // Process registrations. The method is triggered dynamically
+   SC_METHOD( exec_meth );
+}
+
+void schd_dump_close_c::exec_meth(
+      void ) {
+
+   sc_core::sc_time time_next = schd_dump.close_due();
+
+   if( time_next != sc_core::SC_ZERO_TIME ) {
+      sc_core::next_trigger( time_next - sc_core::sc_time_stamp());
+   }
+} // schd_dump_close_c::exec_meth(
+
+} // namespace schd
@@ -0,0 +1,237 @@
+/*
+ * schd_dump_col.cpp
+ *
+ *  Description:
+ *    Writer of the columnar dump files
+ */
+
+#include <cstring>
+#include <fstream>
+#include <boost/foreach.hpp>
+#include <zlib.h>
+#include "schd_dump_col.h"
+
+namespace schd {
+
+schd_dump_col_c::schd_dump_col_c(
+      const std::string& fn_,
+      codec_t            codec_ )
+   : fn( fn_ )
+   , codec( codec_ ) {
+}
+
+schd_dump_col_c::~schd_dump_col_c() {
+   BOOST_FOREACH( file_list_t::value_type& file_el, file_list ) {
+      if( file_el.second.fp != NULL ) {
+         std::fclose( file_el.second.fp );
+      }
+   }
+}
+
+std::string schd_dump_col_c::frame_write(
+      schd_dump_frame_c& frame ) {
+
+   col_file_t& file = file_list[frame.name_hash];
+
+   // Create the column file with the first frame of the buffer
+   if( file.fp == NULL ) {
+      file.fn   = fn + "_" + schd_dump_hash_str( frame.name_hash ) + ".col";
+      file.name = frame.name;
+      file.fp   = std::fopen( file.fn.c_str(), "wb" );
+
+      if( file.fp == NULL ) {
+         return " File I/O error for " + frame.name;
+      }
+
+      col::head_t head;
+
+      std::memcpy( head.magic, col::MAGIC_HEAD, sizeof( head.magic ));
+      head.version = col::VERSION;
+      head.codec   = codec;
+
+      std::string err = write( file, &head, sizeof( head ));
+
+      if( !err.empty()) {
+         return err;
+      }
+   }
+   else if( file.name != frame.name ) {
+      return " hash collision for " + frame.name;
+   }
+
+   // Columns of the block
+   frame.data_str( block_str );
+
+   std::uint64_t rows      = block_str.size();
+   std::uint64_t heap_size = 0;
+
+   BOOST_FOREACH( const std::string& str, block_str ) {
+      heap_size += str.size();
+   }
+
+   block_raw.resize( rows * sizeof( double ) + rows * sizeof( std::uint64_t ) + ( rows + 1 ) * sizeof( std::uint64_t ) + heap_size );
+
+   double*        time_p   = reinterpret_cast<double*>( block_raw.data());
+   std::uint64_t* frame_p  = reinterpret_cast<std::uint64_t*>( time_p + rows );
+   std::uint64_t* offset_p = frame_p + rows;
+   char*          heap_p   = reinterpret_cast<char*>( offset_p + rows + 1 );
+
+   for( std::uint64_t row_idx = 0; row_idx < rows; row_idx ++ ) {
+      // Elements of the frame which is not a batch get the time of the frame end
+      time_p[row_idx]  = ( frame.time.size() == rows ) ? frame.time.at( row_idx ) : frame.time_end;
+      frame_p[row_idx] = frame.frame;
+   }
+
+   std::uint64_t heap_pos = 0;
+
+   for( std::uint64_t row_idx = 0; row_idx < rows; row_idx ++ ) {
+      const std::string& str = block_str.at( row_idx );
+
+      offset_p[row_idx] = heap_pos;
+      std::memcpy( heap_p + heap_pos, str.data(), str.size());
+      heap_pos += str.size();
+   }
+
+   offset_p[rows] = heap_pos;
+
+   // Compress the block if it pays off
+   col::block_t block;
+
+   block.offset     = file.offset;
+   block.size_raw   = block_raw.size();
+   block.rows       = rows;
+   block.row_first  = file.rows;
+   block.frame      = frame.frame;
+   block.time_start = frame.time_start;
+   block.time_end   = frame.time_end;
+   block.codec      = col::CODEC_NONE;
+   block.reserved   = 0;
+
+   const char* data_p = block_raw.data();
+   block.size         = block_raw.size();
+
+   if( codec == col::CODEC_ZLIB ) {
+      uLongf zip_size = compressBound( block_raw.size());
+
+      block_zip.resize( zip_size );
+
+      int res = compress2(
+            reinterpret_cast<Bytef*>( block_zip.data()),
+            &zip_size,
+            reinterpret_cast<const Bytef*>( block_raw.data()),
+            block_raw.size(),
+            Z_BEST_SPEED );
+
+      if( res != Z_OK ) {
+         return " Compression error for " + frame.name;
+      }
+
+      if( zip_size < block_raw.size()) {
+         data_p      = block_zip.data();
+         block.size  = zip_size;
+         block.codec = col::CODEC_ZLIB;
+      }
+   }
+
+   std::string err = write( file, data_p, block.size );
+
+   // Blocks are aligned for the direct access to the columns
+   static const char pad[8] = { 0 };
+
+   if( err.empty() && file.offset % sizeof( std::uint64_t ) != 0 ) {
+      err = write( file, pad, sizeof( std::uint64_t ) - file.offset % sizeof( std::uint64_t ));
+   }
+
+   file.rows += rows;
+   file.block_list.push_back( block );
+
+   return err;
+} // std::string schd_dump_col_c::frame_write(
+
+std::string schd_dump_col_c::close(
+      const schd_dump_index_t& bi ) {
+
+   std::string err;
+
+   // Footer of each column file
+   BOOST_FOREACH( file_list_t::value_type& file_el, file_list ) {
+      col_file_t& file = file_el.second;
+
+      if( file.fp == NULL ) {
+         continue;
+      }
+
+      col::tail_t tail;
+
+      tail.block_offset = file.offset;
+      tail.block_cnt    = file.block_list.size();
+      tail.row_cnt      = file.rows;
+      tail.name_hash    = file_el.first;
+
+      std::string err_file = write( file, file.block_list.data(), file.block_list.size() * sizeof( col::block_t ));
+
+      tail.name_offset = file.offset;
+      tail.name_size   = file.name.size();
+
+      if( err_file.empty()) {
+         std::string name_pad = file.name;
+
+         name_pad.resize(( name_pad.size() + sizeof( std::uint64_t ) - 1 ) / sizeof( std::uint64_t ) * sizeof( std::uint64_t ), '\0' );
+
+         err_file = write( file, name_pad.data(), name_pad.size());
+      }
+
+      std::memcpy( tail.magic, col::MAGIC_TAIL, sizeof( tail.magic ));
+
+      if( err_file.empty()) {
+         err_file = write( file, &tail, sizeof( tail ));
+      }
+
+      if( std::fclose( file.fp ) != 0 && err_file.empty()) {
+         err_file = " file close " + file.fn;
+      }
+
+      file.fp = NULL;
+
+      if( err.empty()) {
+         err = err_file;
+      }
+   } // BOOST_FOREACH( file_list_t::value_type& file_el, file_list )
+
+   // Index of the column files: hash, name and file
+   if( !file_list.empty()) {
+      std::ofstream index_fs( fn.c_str());
+
+      BOOST_FOREACH( const schd_dump_index_t::value_type& be, bi ) {
+         file_list_t::const_iterator file_it = file_list.find( be.first );
+
+         if( file_it != file_list.end()) {
+            index_fs << schd_dump_hash_str( be.first ) << " " << be.second << " " << file_it->second.fn << std::endl;
+         }
+      }
+
+      if( !index_fs && err.empty()) {
+         err = " File I/O error for index " + fn;
+      }
+   }
+
+   file_list.clear();
+
+   return err;
+} // std::string schd_dump_col_c::close(
+
+std::string schd_dump_col_c::write(
+      col_file_t& file,
+      const void* data,
+      std::size_t size ) {
+
+   if( size != 0 && std::fwrite( data, 1, size, file.fp ) != size ) {
+      return " File I/O error for " + file.fn;
+   }
+
+   file.offset += size;
+
+   return std::string();
+} // std::string schd_dump_col_c::write(
+
+} // namespace schd
@@ -0,0 +1,246 @@
+/*
+ * schd_dump_col_rd.cpp
+ *
+ *  Description:
+ *    Reader of the columnar dump file
+ */
+
+#include <algorithm>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <stdexcept>
+#include <unistd.h>
+#include <zlib.h>
+#include "schd_dump_col_rd.h"
+
+namespace schd {
+
+schd_dump_col_rd_c::~schd_dump_col_rd_c() {
+   close();
+}
+
+void schd_dump_col_rd_c::open(
+      const std::string& fn_ ) {
+
+   close();
+
+   fn = fn_;
+   fd = ::open( fn.c_str(), O_RDONLY );
+
+   if( fd < 0 ) {
+      open_error( " File I/O error for " );
+   }
+
+   struct stat st;
+
+   if( ::fstat( fd, &st ) != 0 ) {
+      open_error( " File I/O error for " );
+   }
+
+   map_size = st.st_size;
+
+   if( map_size < sizeof( col::head_t ) + sizeof( col::tail_t )) {
+      open_error( " Incomplete file " );
+   }
+
+   void* map_v = ::mmap( NULL, map_size, PROT_READ, MAP_SHARED, fd, 0 );
+
+   if( map_v == MAP_FAILED ) {
+      open_error( " File I/O error for " );
+   }
+
+   map_p = static_cast<const char*>( map_v );
+
+   // Check the head and the tail
+   const col::head_t* head_p = reinterpret_cast<const col::head_t*>( map_p );
+   tail_p = reinterpret_cast<const col::tail_t*>( map_p + map_size - sizeof( col::tail_t ));
+
+   if( std::memcmp( head_p->magic, col::MAGIC_HEAD, sizeof( head_p->magic )) != 0 ||
+       head_p->version != col::VERSION ) {
+      open_error( " Incorrect format of " );
+   }
+
+   if( std::memcmp( tail_p->magic, col::MAGIC_TAIL, sizeof( tail_p->magic )) != 0 ||
+       tail_p->block_offset + tail_p->block_cnt * sizeof( col::block_t ) > map_size ||
+       tail_p->name_offset  + tail_p->name_size > map_size ) {
+      open_error( " Incomplete file " );
+   }
+
+   block_p  = reinterpret_cast<const col::block_t*>( map_p + tail_p->block_offset );
+   buf_name.assign( map_p + tail_p->name_offset, tail_p->name_size );
+} // schd_dump_col_rd_c::open(
+
+void schd_dump_col_rd_c::close(
+      void ) {
+
+   if( map_p != NULL ) {
+      ::munmap( const_cast<char*>( map_p ), map_size );
+   }
+
+   if( fd >= 0 ) {
+      ::close( fd );
+   }
+
+   fd       = -1;
+   map_p    = NULL;
+   map_size = 0;
+   tail_p   = NULL;
+   block_p  = NULL;
+   cache_en = false;
+   buf_name.clear();
+} // schd_dump_col_rd_c::close(
+
+void schd_dump_col_rd_c::open_error(
+      const std::string& msg ) {
+
+   std::string fn_err = fn;
+
+   close();
+
+   throw std::runtime_error( "schd::dump_col:" + msg + fn_err );
+} // schd_dump_col_rd_c::open_error(
+
+schd_dump_col_rd_c::row_t schd_dump_col_rd_c::row(
+      std::size_t row_idx ) {
+
+   if( row_idx >= rows()) {
+      throw std::out_of_range( "schd::dump_col: Row " + std::to_string( row_idx ) + " is out of range in " + fn );
+   }
+
+   std::size_t         block_idx = block_find( row_idx );
+   const col::block_t& blk       = block_p[block_idx];
+   const char*         data_p    = block_data( block_idx );
+   std::size_t         blk_row   = row_idx - blk.row_first;
+
+   const double*        time_p   = reinterpret_cast<const double*>( data_p );
+   const std::uint64_t* frame_p  = reinterpret_cast<const std::uint64_t*>( time_p + blk.rows );
+   const std::uint64_t* offset_p = frame_p + blk.rows;
+   const char*          heap_p   = reinterpret_cast<const char*>( offset_p + blk.rows + 1 );
+
+   // Size of the heap is checked by block_data
+   if( blk_row >= blk.rows ||
+       offset_p[blk_row] > offset_p[blk_row + 1] ||
+       offset_p[blk_row + 1] > offset_p[blk.rows] ) {
+      throw std::runtime_error( "schd::dump_col: Incorrect block " + std::to_string( block_idx ) + " in " + fn );
+   }
+
+   row_t row_data;
+
+   row_data.time  = time_p[blk_row];
+   row_data.frame = frame_p[blk_row];
+   row_data.data  = heap_p + offset_p[blk_row];
+   row_data.size  = offset_p[blk_row + 1] - offset_p[blk_row];
+
+   return row_data;
+} // schd_dump_col_rd_c::row(
+
+std::size_t schd_dump_col_rd_c::lower_bound(
+      double time ) {
+
+   // Blocks are in the order of the time. Find the first block which ends at or after the time
+   const col::block_t* blk_p = std::lower_bound(
+         block_p,
+         block_p + blocks(),
+         time,
+         []( const col::block_t& blk, double t )->bool {
+            return blk.time_end < t; } );
+
+   if( blk_p == block_p + blocks()) {
+      return rows();
+   }
+
+   // Time column of the block
+   const double* time_p = reinterpret_cast<const double*>( block_data( blk_p - block_p ));
+
+   return blk_p->row_first + ( std::lower_bound( time_p, time_p + blk_p->rows, time ) - time_p );
+} // schd_dump_col_rd_c::lower_bound(
+
+const char* schd_dump_col_rd_c::block_data(
+      std::size_t block_idx ) {
+
+   const col::block_t& blk = block_p[block_idx];
+
+   if( blk.size > map_size || blk.offset > map_size - blk.size ) {
+      throw std::runtime_error( "schd::dump_col: Incorrect block " + std::to_string( block_idx ) + " in " + fn );
+   }
+
+   if( blk.codec == col::CODEC_NONE ) {
+      if( blk.size_raw > blk.size ) {
+         throw std::runtime_error( "schd::dump_col: Incorrect block " + std::to_string( block_idx ) + " in " + fn );
+      }
+
+      block_check( block_idx, map_p + blk.offset );
+
+      return map_p + blk.offset;
+   }
+   else if( blk.codec != col::CODEC_ZLIB ) {
+      throw std::runtime_error( "schd::dump_col: Unsupported codec in " + fn );
+   }
+
+   if( !cache_en || cache_idx != block_idx ) {
+      // Cache is not valid until the block is inflated and checked
+      cache_en = false;
+
+      cache.resize(( blk.size_raw + sizeof( std::uint64_t ) - 1 ) / sizeof( std::uint64_t ));
+
+      uLongf size_raw = blk.size_raw;
+
+      int res = uncompress(
+            reinterpret_cast<Bytef*>( cache.data()),
+            &size_raw,
+            reinterpret_cast<const Bytef*>( map_p + blk.offset ),
+            blk.size );
+
+      if( res != Z_OK || size_raw != blk.size_raw ) {
+         throw std::runtime_error( "schd::dump_col: Decompression error in " + fn );
+      }
+
+      // Inflated block is checked once
+      block_check( block_idx, reinterpret_cast<const char*>( cache.data()));
+
+      cache_idx = block_idx;
+      cache_en  = true;
+   }
+
+   return reinterpret_cast<const char*>( cache.data());
+} // schd_dump_col_rd_c::block_data(
+
+void schd_dump_col_rd_c::block_check(
+      std::size_t block_idx,
+      const char* data_p ) const {
+
+   const col::block_t& blk = block_p[block_idx];
+
+   // Time, frame and offset columns fit to the block, the end of the heap fits after them
+   const std::uint64_t col_size = 3 * sizeof( std::uint64_t );
+
+   if( blk.size_raw < sizeof( std::uint64_t ) ||
+       blk.rows > ( blk.size_raw - sizeof( std::uint64_t )) / col_size ) {
+      throw std::runtime_error( "schd::dump_col: Incorrect block " + std::to_string( block_idx ) + " in " + fn );
+   }
+
+   const std::uint64_t  heap_base = blk.rows * col_size + sizeof( std::uint64_t );
+   const std::uint64_t* offset_p  = reinterpret_cast<const std::uint64_t*>( data_p ) + 2 * blk.rows;
+
+   if( offset_p[blk.rows] > blk.size_raw - heap_base ) {
+      throw std::runtime_error( "schd::dump_col: Incorrect block " + std::to_string( block_idx ) + " in " + fn );
+   }
+} // schd_dump_col_rd_c::block_check(
+
+std::size_t schd_dump_col_rd_c::block_find(
+      std::size_t row_idx ) const {
+
+   // Last block which starts at or before the row
+   const col::block_t* blk_p = std::upper_bound(
+         block_p,
+         block_p + blocks(),
+         row_idx,
+         []( std::size_t r, const col::block_t& blk )->bool {
+            return r < blk.row_first; } );
+
+   return ( blk_p - block_p ) - 1;
+} // schd_dump_col_rd_c::block_find(
+
+} // namespace schd
@@ -0,0 +1,368 @@
+/*
+ * schd_dump_mat.cpp
+ *
+ *  Description:
+ *    MAT5 dump file format
+ */
+
+#include <boost/foreach.hpp>
+#include "schd_dump_mat.h"
+
+namespace schd {
+
+schd_dump_mat_c::schd_dump_mat_c(
+      const std::string& fn_ )
+   : fn( fn_ ) {
+}
+
+schd_dump_mat_c::~schd_dump_mat_c() {
+   if( fp != NULL ) {
+      Mat_Close( fp );
+   }
+}
+
+// Create dump variable and write it to the file
+std::string schd_dump_mat_c::frame_write(
+      schd_dump_frame_c& job ) {
+
+   // Create mat structure
+   const unsigned matstr_nfields = job.time.empty() ? 5 : 6;
+   const char    *matstr_fields[6] = {
+        "name",         // Full name
+        "frame",        // Frame counter
+        "time_start",   // Frame start (simulation time)
+        "time_end",     // Frame end   (simulation time)
+        "data",         // Data
+        "time" };       // Time of each element of the batch
+   const int     matstr_rank = 2;
+         size_t  matstr_dims[matstr_rank] = {1, 1};
+
+   // Variable name
+   std::stringstream os; // Convert frame counter
+   os << std::setfill('0')
+      << std::setw( sizeof( job.frame ) * 2 )
+      << std::hex
+      << job.frame;
+
+   std::string matstr_name = "v" + schd_dump_hash_str( job.name_hash ) + "_f" + os.str();
+
+   matvar_t *matstr_p = Mat_VarCreateStruct(
+         matstr_name.c_str(),
+         matstr_rank,
+         matstr_dims,
+         matstr_fields,
+         matstr_nfields );
+
+   if( matstr_p == NULL ) {
+      return " struct for " + job.name;
+   }
+
+   matvar_t *field_p;
+   const int field_rank = 2;
+   size_t    field_dims[field_rank] = {1, 1};
+
+   // Update start time
+   field_p = Mat_VarCreate(
+         NULL,
+         MAT_C_DOUBLE,
+         MAT_T_DOUBLE,
+         field_rank,
+         field_dims,
+         (void *)&job.time_start,
+         MAT_F_DONT_COPY_DATA );
+
+   if( field_p == NULL ) {
+      Mat_VarFree( matstr_p );
+      return " struct field for " + job.name;
+   }
+
+   Mat_VarSetStructFieldByName(
+         matstr_p,
+         "time_start",
+         0,
+         field_p );
+
+   // Update end time
+   field_p = Mat_VarCreate(
+         NULL,
+         MAT_C_DOUBLE,
+         MAT_T_DOUBLE,
+         field_rank,
+         field_dims,
+         (void *)&job.time_end,
+         MAT_F_DONT_COPY_DATA );
+
+   if( field_p == NULL ) {
+      Mat_VarFree( matstr_p );
+      return " struct field for " + job.name;
+   }
+
+   Mat_VarSetStructFieldByName(
+         matstr_p,
+         "time_end",
+         0,
+         field_p );
+
+   // Update frame count
+   uint64_t frame = job.frame;
+   field_p = Mat_VarCreate(
+         NULL,
+         MAT_C_UINT64,
+         MAT_T_UINT64,
+         field_rank,
+         field_dims,
+         (void *)&frame,
+         MAT_F_DONT_COPY_DATA );
+
+   if( field_p == NULL ) {
+      Mat_VarFree( matstr_p );
+      return " struct field for " + job.name;
+   }
+
+   Mat_VarSetStructFieldByName(
+         matstr_p,
+         "frame",
+         0,
+         field_p );
+
+   // Call data writer
+   field_p = job.data_mat();
+
+   if( field_p == NULL ) {
+      Mat_VarFree( matstr_p );
+      return " struct field for " + job.name;
+   }
+
+   Mat_VarSetStructFieldByName(
+         matstr_p,
+         "data",
+         0,
+         field_p );
+
+   // Update time of the elements
+   if( !job.time.empty()) {
+      field_dims[0] = 1;
+      field_dims[1] = job.time.size();
+
+      field_p = Mat_VarCreate(
+            NULL,
+            MAT_C_DOUBLE,
+            MAT_T_DOUBLE,
+            field_rank,
+            field_dims,
+            (void *)job.time.data(),
+            MAT_F_DONT_COPY_DATA );
+
+      if( field_p == NULL ) {
+         Mat_VarFree( matstr_p );
+         return " struct field for " + job.name;
+      }
+
+      Mat_VarSetStructFieldByName(
+            matstr_p,
+            "time",
+            0,
+            field_p );
+   }
+
+   // Update name
+   field_dims[0] = 1;
+   field_dims[1] = job.name.size();
+
+   field_p = Mat_VarCreate(
+         NULL,
+         MAT_C_CHAR,
+         MAT_T_UTF8,
+         field_rank,
+         field_dims,
+         (void *)job.name.c_str(),
+         MAT_F_DONT_COPY_DATA );
+
+   if( field_p == NULL ) {
+      Mat_VarFree( matstr_p );
+      return " struct field for " + job.name;
+   }
+
+   Mat_VarSetStructFieldByName(
+         matstr_p,
+         "name",
+         0,
+         field_p );
+
+   // Check if the file needs to be created
+   if( fp == NULL ) {
+      fp = Mat_CreateVer(
+            fn.c_str(),
+            NULL,
+            MAT_FILE_VER );
+
+      if( fp == NULL ) {
+         Mat_VarFree( matstr_p );
+         return " File I/O error for " + job.name;
+      }
+   }
+
+   // Write structure to a file
+   int res = Mat_VarWrite(
+         fp,
+         matstr_p,
+         MAT_COMPRESSION );
+
+   // Free memory
+   Mat_VarFree( matstr_p );
+
+   if( res != 0 ) {
+      return " File I/O error for " + job.name + " ret:" + std::to_string( res );
+   }
+
+   return std::string();
+} // std::string schd_dump_mat_c::frame_write(
+
+std::string schd_dump_mat_c::close(
+      const schd_dump_index_t& bi ) {
+
+   if( fp == NULL ) {
+      return std::string();
+   }
+
+   std::string err = write_index( bi );
+
+   int res = Mat_Close(
+         fp );
+
+   fp = NULL;
+
+   if( err.empty() && res != 0 ) {
+      err = " file close " + fn;
+   }
+
+   return err;
+} // std::string schd_dump_mat_c::close(
+
+// Save hash-name index to mat file
+std::string schd_dump_mat_c::write_index(
+      const schd_dump_index_t& bi ) {
+
+   // Create mat structure
+   const unsigned matstr_nfields = 3;
+   const char    *matstr_fields[matstr_nfields] = {
+        "hash",         // name hash
+        "hash_str",     // name hash (string representation)
+        "name" };       // full name
+
+   const int     matstr_rank = 2;
+         size_t  matstr_dims[matstr_rank] = {bi.size(), 1};
+
+   if( bi.size() == 0 ) {
+      return std::string();
+   }
+
+   matvar_t *matstr_p = Mat_VarCreateStruct(
+         "index",
+         matstr_rank,
+         matstr_dims,
+         matstr_fields,
+         matstr_nfields );
+
+   if( matstr_p == NULL ) {
+      return " struct for index";
+   }
+
+   std::size_t bi_idx = 0;
+
+   BOOST_FOREACH( const schd_dump_index_t::value_type &be, bi ) {
+      matvar_t *field_p;
+      const int field_rank = 2;
+      size_t    field_dims[field_rank];
+
+      // Save hash
+      uint64_t name_hash = be.first;
+      field_dims[0] = 1;
+      field_dims[1] = 1;
+      field_p = Mat_VarCreate(
+            NULL,
+            MAT_C_UINT64,
+            MAT_T_UINT64,
+            field_rank,
+            field_dims,
+            (void *)&name_hash,
+            0 );
+
+      if( field_p == NULL ) {
+         Mat_VarFree( matstr_p );
+         return " struct field for index";
+      }
+
+      Mat_VarSetStructFieldByName(
+            matstr_p,
+            "hash",
+            bi_idx,
+            field_p );
+
+      // Save hash string
+      std::string name_hash_str = schd_dump_hash_str( be.first );
+      field_dims[0] = 1;
+      field_dims[1] = name_hash_str.size();
+      field_p = Mat_VarCreate(
+            NULL,
+            MAT_C_CHAR,
+            MAT_T_UTF8,
+            field_rank,
+            field_dims,
+            (void *)name_hash_str.c_str(),
+            0 );
+
+      if( field_p == NULL ) {
+         Mat_VarFree( matstr_p );
+         return " struct field for index";
+      }
+
+      Mat_VarSetStructFieldByName(
+            matstr_p,
+            "hash_str",
+            bi_idx,
+            field_p );
+
+      // Save name
+      field_dims[0] = 1;
+      field_dims[1] = be.second.size();
+      field_p = Mat_VarCreate(
+            NULL,
+            MAT_C_CHAR,
+            MAT_T_UTF8,
+            field_rank,
+            field_dims,
+            (void *)be.second.c_str(),
+            MAT_F_DONT_COPY_DATA );
+
+      if( field_p == NULL ) {
+         Mat_VarFree( matstr_p );
+         return " struct field for index";
+      }
+
+      Mat_VarSetStructFieldByName(
+            matstr_p,
+            "name",
+            bi_idx,
+            field_p );
+
+      bi_idx ++;
+   }
+
+   // Write structure to a file
+   int res = Mat_VarWrite(
+         fp,
+         matstr_p,
+         MAT_COMPRESSION );
+
+   // Free memory
+   Mat_VarFree( matstr_p );
+
+   if( res != 0 ) {
+      return " File I/O error for index";
+   }
+
+   return std::string();
+}
+
+} // namespace schd
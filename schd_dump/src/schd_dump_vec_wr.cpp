@@ -4,6 +4,7 @@
  *  Description:
  *    Vector writers for different data types
  */
+#include <stdexcept>
 #include <boost/property_tree/detail/file_parser_error.hpp>
 #include <boost/foreach.hpp>
 #include "schd_dump_vec_wr.h"
@@ -12,6 +13,18 @@
 
 namespace schd {
 
+// Writers are executed by the background threads: errors are thrown instead of the report
+static void pt2str_check(
+      const boost_pt::ptree& pt,
+      std::string&           str ) {
+
+   std::string err = pt2str_err( pt, str );
+
+   if( !err.empty()) {
+      throw std::runtime_error( " JSON conversion error: " + err );
+   }
+}
+
 matvar_t *vec_writer(
       const std::vector<int> &vec ) {
 
@@ -235,12 +248,21 @@ matvar_t *vec_writer(
 matvar_t *vec_writer(
       const std::vector<boost_pt::ptree> &vec ) {
 
-   std::vector<std::string> vec_conv( vec.size());
+   std::vector<std::string> vec_conv;
+
+   return vec_writer( vec, vec_conv );
+}
+
+matvar_t *vec_writer(
+      const std::vector<boost_pt::ptree> &vec,
+      std::vector<std::string> &vec_conv ) {
+
+   vec_conv.resize( vec.size());
 
    std::size_t vec_idx = 0;
 
    BOOST_FOREACH( const boost_pt::ptree &el, vec ) {
-      pt2str( el, vec_conv.at( vec_idx ));
+      pt2str_check( el, vec_conv.at( vec_idx ));
 
       vec_idx ++;
    }
@@ -248,4 +270,26 @@ matvar_t *vec_writer(
    return vec_writer( vec_conv, true );
 }
 
+void vec_str_writer(
+      const std::vector<std::string> &vec,
+      std::vector<std::string> &str ) {
+
+   str = vec;
+}
+
+void vec_str_writer(
+      const std::vector<boost_pt::ptree> &vec,
+      std::vector<std::string> &str ) {
+
+   str.resize( vec.size());
+
+   std::size_t vec_idx = 0;
+
+   BOOST_FOREACH( const boost_pt::ptree &el, vec ) {
+      pt2str_check( el, str.at( vec_idx ));
+
+      vec_idx ++;
+   }
+}
+
 } // namespace schd
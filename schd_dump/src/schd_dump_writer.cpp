@@ -0,0 +1,143 @@
+/*
+ * schd_dump_writer.cpp
+ *
+ *  Description:
+ *    Methods of the background dump writer
+ */
+
+#include <chrono>
+#include <exception>
+#include <boost/foreach.hpp>
+#include "schd_dump_writer.h"
+#include "schd_report.h"
+
+namespace schd {
+
+schd_dump_writer_c::~schd_dump_writer_c() {
+   // Threads must not outlive the writer
+   stop.store( true );
+
+   BOOST_FOREACH( std::unique_ptr<worker_t>& worker_p, worker_list ) {
+      if( worker_p->thrd.joinable()) {
+         worker_p->cv.notify_one();
+         worker_p->thrd.join();
+      }
+   }
+} // schd_dump_writer_c::~schd_dump_writer_c(
+
+void schd_dump_writer_c::init(
+      std::size_t thrd_num,
+      std::size_t queue_size ) {
+
+   if( queue_size == 0 ) {
+      SCHD_REPORT_ERROR( "schd::sys_dump" ) << " Incorrect size of the writer queue";
+   }
+
+   stop.store( false );
+
+   for( std::size_t thrd_idx = 0; thrd_idx < thrd_num; thrd_idx ++ ) {
+      worker_list.push_back( std::unique_ptr<worker_t>( new worker_t( queue_size )));
+   }
+
+   // Threads are started when the list is complete
+   BOOST_FOREACH( std::unique_ptr<worker_t>& worker_p, worker_list ) {
+      worker_p->thrd = std::thread( &schd_dump_writer_c::run, this, std::ref( *worker_p ));
+   }
+} // schd_dump_writer_c::init(
+
+void schd_dump_writer_c::push(
+      std::size_t        key,
+      schd_dump_job_ptr& job_p ) {
+
+   worker_t& worker = *worker_list.at( key % worker_list.size());
+
+   // Back-pressure: the simulation waits while the writer is behind
+   while( !worker.queue.push( job_p )) {
+      worker.cv.notify_one();
+      std::this_thread::yield();
+   }
+
+   worker.cv.notify_one();
+
+   error_check();
+} // schd_dump_writer_c::push(
+
+void schd_dump_writer_c::join(
+      void ) {
+
+   // Threads drain their queues before they exit
+   stop.store( true );
+
+   BOOST_FOREACH( std::unique_ptr<worker_t>& worker_p, worker_list ) {
+      worker_p->cv.notify_one();
+      worker_p->thrd.join();
+   }
+
+   worker_list.clear();
+
+   error_check();
+} // schd_dump_writer_c::join(
+
+void schd_dump_writer_c::run(
+      worker_t& worker ) {
+   schd_dump_job_ptr job_p;
+
+   while( true ) {
+      if( worker.queue.pop( job_p )) {
+         std::string err;
+
+         // Exceptions must not leave the thread. They are reported by the simulation thread
+         try {
+            err = job_p->exec();
+         }
+         catch( const std::exception& err_ex ) {
+            err = err_ex.what();
+         }
+         catch( ... ) {
+            err = " Unexpected error in the dump writer";
+         }
+
+         job_p.reset();
+
+         if( !err.empty()) {
+            std::lock_guard<std::mutex> lock( err_mtx );
+
+            if( err_str.empty()) {
+               err_str = err;
+            }
+         }
+      }
+      else if( stop.load()) {
+         // Jobs which were pushed before the stop are already visible
+         if( worker.queue.empty()) {
+            break;
+         }
+      }
+      else {
+         // Timeout covers the notification which arrives before the wait
+         std::unique_lock<std::mutex> lock( worker.mtx );
+
+         worker.cv.wait_for(
+               lock,
+               std::chrono::milliseconds( 1 ),
+               [this, &worker]()->bool {
+                  return !worker.queue.empty() || stop.load(); } );
+      }
+   } // while( true )
+} // schd_dump_writer_c::run(
+
+void schd_dump_writer_c::error_check(
+      void ) {
+   std::string err;
+
+   {
+      std::lock_guard<std::mutex> lock( err_mtx );
+      err.swap( err_str );
+   }
+
+   if( !err.empty()) {
+      SCHD_REPORT_ERROR( "schd::sys_dump" ) << err;
+   }
+} // schd_dump_writer_c::error_check(
+
+} // namespace schd
@@ -0,0 +1,249 @@
+/*
+ * schd_dump_col_check.cpp
+ *
+ *  Description:
+ *    Round trip of the columnar dump: frames are written by schd_dump_col_c and read back
+ *    by schd_dump_col_rd_c. Covers the uncompressed and zlib blocks, lower_bound and a corrupt block.
+ *    Files are created in the current directory. Returns non-zero if a check fails
+ */
+
+#include <cstdio>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include "schd_dump_col.h"
+#include "schd_dump_col_rd.h"
+
+namespace {
+
+   const std::size_t FRAME_CNT = 20;
+   const std::size_t NAME_HASH = 0x5c4d;
+   const char*       NAME      = "top.exec.plan_i";
+
+   int err_cnt = 0;
+
+   void check(
+         bool               ok,
+         const std::string& msg ) {
+
+      if( !ok ) {
+         std::cerr << "FAILED: " << msg << std::endl;
+         err_cnt ++;
+      }
+   } // check(
+
+   // Frame with the string data. Matlab output is not used by the columnar format
+   class frame_c
+   : public schd::schd_dump_frame_c {
+   public:
+      std::vector<std::string> data;
+
+      matvar_t* data_mat(
+            void ) {
+         return NULL;
+      }
+
+      void data_str(
+            std::vector<std::string>& str ) {
+         str = data;
+      }
+   }; // class frame_c
+
+   // Frame f has f % 4 elements at times 10 * f + i. Elements repeat a letter, so they deflate
+   std::string elem(
+         std::size_t row_idx ) {
+      return std::string( row_idx % 5 * 16 + 1, static_cast<char>( 'a' + row_idx % 26 ));
+   }
+
+   const std::string FN     = "schd_dump_col_check.idx";
+   const std::string FN_COL = FN + "_" + schd::schd_dump_hash_str( NAME_HASH ) + ".col";
+
+   // Write the frames. Returns the number of the elements
+   std::size_t file_write(
+         schd::schd_dump_col_c::codec_t codec,
+         const std::string&             codec_nm ) {
+
+      std::size_t row_cnt = 0;
+
+      {
+         schd::schd_dump_col_c wr( FN, codec );
+
+         for( std::size_t frame_idx = 0; frame_idx < FRAME_CNT; frame_idx ++ ) {
+            frame_c frame;
+
+            frame.name       = NAME;
+            frame.name_hash  = NAME_HASH;
+            frame.frame      = frame_idx;
+            frame.time_start = 10.0 * frame_idx;
+            frame.time_end   = 10.0 * frame_idx + 5.0;
+
+            for( std::size_t el_idx = 0; el_idx < frame_idx % 4; el_idx ++ ) {
+               frame.data.push_back( elem( row_cnt ));
+               frame.time.push_back( 10.0 * frame_idx + el_idx );
+               row_cnt ++;
+            }
+
+            check( wr.frame_write( frame ).empty(), codec_nm + ": frame_write" );
+         }
+
+         schd::schd_dump_index_t bi;
+         bi[NAME_HASH] = NAME;
+
+         check( wr.close( bi ).empty(), codec_nm + ": close" );
+      }
+
+      return row_cnt;
+   } // file_write(
+
+   void check_codec(
+         schd::schd_dump_col_c::codec_t codec ) {
+
+      const std::string codec_nm = codec == schd::schd_dump_col_c::CODEC_ZLIB ? "zlib" : "none";
+      const std::size_t row_cnt  = file_write( codec, codec_nm );
+
+      // Read
+      schd::schd_dump_col_rd_c rd;
+
+      rd.open( FN_COL );
+
+      check( rd.name() == NAME, codec_nm + ": buffer name" );
+      check( rd.name_hash() == NAME_HASH, codec_nm + ": name hash" );
+      check( rd.rows() == row_cnt, codec_nm + ": row count" );
+
+      bool block_zip = false;
+
+      for( std::size_t block_idx = 0; block_idx < rd.blocks(); block_idx ++ ) {
+         block_zip |= rd.block( block_idx ).codec == schd::col::CODEC_ZLIB;
+      }
+
+      check( block_zip == ( codec == schd::schd_dump_col_c::CODEC_ZLIB ), codec_nm + ": block codec" );
+
+      std::size_t row_idx = 0;
+
+      for( std::size_t frame_idx = 0; frame_idx < FRAME_CNT; frame_idx ++ ) {
+         for( std::size_t el_idx = 0; el_idx < frame_idx % 4; el_idx ++ ) {
+            schd::schd_dump_col_rd_c::row_t row = rd.row( row_idx );
+
+            check( row.frame == frame_idx &&
+                   row.time  == 10.0 * frame_idx + el_idx &&
+                   std::string( row.data, row.size ) == elem( row_idx ),
+                   codec_nm + ": row " + std::to_string( row_idx ));
+
+            row_idx ++;
+         }
+      }
+
+      // Frame 10 has 2 elements at 100 and 101, frame 11 starts at 110
+      std::size_t lb_idx = rd.lower_bound( 101.0 );
+
+      check( lb_idx < rd.rows() && rd.row( lb_idx ).time == 101.0 && rd.row( lb_idx - 1 ).time == 100.0,
+             codec_nm + ": lower_bound within a frame" );
+
+      lb_idx = rd.lower_bound( 102.0 );
+
+      check( lb_idx < rd.rows() && rd.row( lb_idx ).time == 110.0,
+             codec_nm + ": lower_bound between the frames" );
+
+      check( rd.lower_bound( 0.0 ) == 0, codec_nm + ": lower_bound before the first row" );
+      check( rd.lower_bound( 1000.0 ) == rd.rows(), codec_nm + ": lower_bound after the last row" );
+
+      bool range_err = false;
+
+      try {
+         rd.row( rd.rows());
+      }
+      catch( const std::out_of_range& ) {
+         range_err = true;
+      }
+
+      check( range_err, codec_nm + ": row out of range" );
+
+      rd.close();
+
+      std::remove( FN.c_str());
+      std::remove( FN_COL.c_str());
+
+      bool open_err = false;
+
+      try {
+         rd.open( FN_COL );
+      }
+      catch( const std::runtime_error& ) {
+         open_err = true;
+      }
+
+      check( open_err, codec_nm + ": open of a missing file" );
+   } // check_codec(
+
+   // End of the heap in an uncompressed block points past the block
+   void check_corrupt(
+         void ) {
+
+      file_write( schd::schd_dump_col_c::CODEC_NONE, "corrupt" );
+
+      schd::schd_dump_col_rd_c rd;
+
+      rd.open( FN_COL );
+
+      // First block with the elements. It has row 0
+      std::size_t block_idx = 0;
+
+      while( rd.block( block_idx ).rows == 0 ) {
+         block_idx ++;
+      }
+
+      const schd::col::block_t& blk = rd.block( block_idx );
+
+      // Last element of the offset column is the end of the heap
+      std::uint64_t heap_end   = blk.size_raw;
+      std::uint64_t end_offset = blk.offset + 3 * blk.rows * sizeof( std::uint64_t );
+
+      rd.close();
+
+      std::FILE* fp = std::fopen( FN_COL.c_str(), "r+b" );
+
+      check( fp != NULL &&
+             std::fseek( fp, static_cast<long>( end_offset ), SEEK_SET ) == 0 &&
+             std::fwrite( &heap_end, sizeof( heap_end ), 1, fp ) == 1,
+             "corrupt: file update" );
+
+      if( fp != NULL ) {
+         std::fclose( fp );
+      }
+
+      rd.open( FN_COL );
+
+      bool block_err = false;
+
+      try {
+         rd.row( 0 );
+      }
+      catch( const std::runtime_error& ) {
+         block_err = true;
+      }
+
+      check( block_err, "corrupt: end of the heap out of the block" );
+
+      rd.close();
+
+      std::remove( FN.c_str());
+      std::remove( FN_COL.c_str());
+   } // check_corrupt(
+} // namespace
+
+int main(
+      void ) {
+
+   try {
+      check_codec( schd::schd_dump_col_c::CODEC_NONE );
+      check_codec( schd::schd_dump_col_c::CODEC_ZLIB );
+      check_corrupt();
+   }
+   catch( const std::exception& err ) {
+      std::cerr << "FAILED: " << err.what() << std::endl;
+      err_cnt ++;
+   }
+
+   return err_cnt == 0 ? 0 : 1;
+} // main(
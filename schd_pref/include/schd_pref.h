@@ -37,6 +37,7 @@ namespace schd {
       boost::optional<const boost_pt::ptree&> task_p;  // Tasks / procedures
       boost::optional<const boost_pt::ptree&> exec_p;  // Executors
       boost::optional<const boost_pt::ptree&> cres_p;  // Common resources
+      boost::optional<const boost_pt::ptree&> core_p;  // Simulation engine options (optional)
 
       boost::optional<const boost_pt::ptree&> time_p;
       boost::optional<const boost_pt::ptree&> report_p;
@@ -59,6 +59,7 @@ void schd_pref_c::parse(
    report_p = get_pref( "report",    check_error );
    trace_p  = get_pref( "trace",     check_error );
    dump_p   = get_pref( "dump",      check_error );
+   core_p   = get_pref( "core",      false       );
 } // schd_pref_c::parse(
 
 } // namespace schd